@@ -36,6 +36,9 @@ protected:
   BehavSupport m_support;
 
   mutable bool m_cacheValid;
+  /// The information sets whose probabilities have changed since the
+  /// cached data were computed, when there are only a few
+  mutable Array<GameTreeInfosetRep *> m_changedInfosets;
 
   // structures for storing cached data: nodes
   mutable Vector<T> m_realizProbs, m_beliefs, m_nvals, m_bvals;
@@ -61,9 +64,17 @@ protected:
   //@{
   void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
   
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
   void ComputeSolutionData(void) const;
+  /// Update the cached data after changes at m_changedInfosets only
+  void UpdateSolutionData(void) const;
+  //@}
+
+  /// @name Tracking changes to the profile
+  //@{
+  /// Notes a change to the probabilities at the information set
+  void InvalidateInfoset(int pl, int iset) const;
+  /// Notes a change to the p_index'th entry of the profile
+  void InvalidateIndex(int p_index) const;
   //@}
 
   /// @name Converting mixed strategies to behavior
@@ -113,11 +124,11 @@ public:
   const T &operator()(int a, int b, int c) const
     { return DVector<T>::operator()(a, b, c); }
   T &operator()(int a, int b, int c) 
-    { Invalidate();  return DVector<T>::operator()(a, b, c); }
+    { InvalidateInfoset(a, b);  return DVector<T>::operator()(a, b, c); }
   const T &operator[](int a) const
     { return Array<T>::operator[](a); }
   T &operator[](int a)
-    { Invalidate();  return Array<T>::operator[](a); }
+    { InvalidateIndex(a);  return Array<T>::operator[](a); }
 
   MixedBehavProfile<T> &operator+=(const MixedBehavProfile<T> &x)
     { Invalidate();  DVector<T>::operator+=(x);  return *this; }
@@ -0,0 +1,158 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/binfile.cc
+// Low-level reading and writing of binary game savefiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <climits>
+#include <cstring>
+
+#include "binfile.h"
+
+namespace Gambit {
+
+namespace {
+
+// The signature is laid out as that of PNG files, so that transfers
+// which mangle line endings or the high bit are caught
+const char SIGNATURE[] = "\211GBG\r\n\032\n";
+const int SIGNATURE_LENGTH = 8;
+const int BYTE_ORDER_MARK = 0x01020304;
+
+int SwapBytes(int p_value)
+{
+  unsigned int value = p_value;
+  return (int) ((value >> 24) | ((value >> 8) & 0xff00u) |
+		((value << 8) & 0xff0000u) | (value << 24));
+}
+
+} // end anonymous namespace
+
+bool IsBinaryGameFile(std::istream &p_file)
+{
+  return (p_file.peek() == (unsigned char) SIGNATURE[0]);
+}
+
+//========================================================================
+//                     class BinaryGameWriter
+//========================================================================
+
+BinaryGameWriter::BinaryGameWriter(std::ostream &p_file,
+				   BinaryGameKind p_kind)
+  : m_file(p_file)
+{
+  m_file.write(SIGNATURE, SIGNATURE_LENGTH);
+  WriteInt(BYTE_ORDER_MARK);
+  WriteInt(BINARY_FILE_VERSION);
+  WriteInt(p_kind);
+}
+
+void BinaryGameWriter::WriteInt(int p_value)
+{
+  m_file.write((const char *) &p_value, sizeof(int));
+}
+
+void BinaryGameWriter::WriteInts(const int *p_values, long p_count)
+{
+  m_file.write((const char *) p_values, p_count * sizeof(int));
+}
+
+void BinaryGameWriter::WriteString(const std::string &p_value)
+{
+  WriteInt(p_value.length());
+  m_file.write(p_value.data(), p_value.length());
+}
+
+//========================================================================
+//                     class BinaryGameReader
+//========================================================================
+
+BinaryGameReader::BinaryGameReader(std::istream &p_file)
+  : m_file(p_file), m_swapBytes(false)
+{
+  char signature[SIGNATURE_LENGTH];
+  m_file.read(signature, SIGNATURE_LENGTH);
+  if (m_file.gcount() != SIGNATURE_LENGTH ||
+      memcmp(signature, SIGNATURE, SIGNATURE_LENGTH) != 0) {
+    throw InvalidFileException("Binary game file signature is damaged");
+  }
+
+  int mark = ReadInt();
+  if (mark != BYTE_ORDER_MARK) {
+    if (SwapBytes(mark) != BYTE_ORDER_MARK) {
+      throw InvalidFileException("Binary game file has unknown byte order");
+    }
+    m_swapBytes = true;
+  }
+
+  if (ReadInt() != BINARY_FILE_VERSION) {
+    throw InvalidFileException("Accepting only binary game file version 1");
+  }
+  m_kind = (BinaryGameKind) ReadInt(BINARY_GAME_TABLE, BINARY_GAME_TREE);
+}
+
+int BinaryGameReader::ReadInt(void)
+{
+  int value;
+  ReadInts(&value, 1);
+  return value;
+}
+
+int BinaryGameReader::ReadInt(int p_min, int p_max)
+{
+  int value = ReadInt();
+  if (value < p_min || value > p_max) {
+    throw InvalidFileException("Value out of range in binary game file");
+  }
+  return value;
+}
+
+void BinaryGameReader::ReadInts(int *p_values, long p_count)
+{
+  m_file.read((char *) p_values, p_count * sizeof(int));
+  if (m_file.gcount() != (std::streamsize) (p_count * sizeof(int))) {
+    throw InvalidFileException("Unexpected end of binary game file");
+  }
+  if (m_swapBytes) {
+    for (long i = 0; i < p_count; i++) {
+      p_values[i] = SwapBytes(p_values[i]);
+    }
+  }
+}
+
+std::string BinaryGameReader::ReadString(void)
+{
+  // The string is read in pieces, so a damaged length fails at the
+  // end of the file instead of allocating the whole length up front
+  int length = ReadInt(0, INT_MAX);
+  std::string value;
+  char buffer[4096];
+  while (length > 0) {
+    int count = (length < (int) sizeof(buffer)) ? length : sizeof(buffer);
+    m_file.read(buffer, count);
+    if (m_file.gcount() != count) {
+      throw InvalidFileException("Unexpected end of binary game file");
+    }
+    value.append(buffer, count);
+    length -= count;
+  }
+  return value;
+}
+
+} // end namespace Gambit
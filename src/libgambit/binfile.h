@@ -0,0 +1,91 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/binfile.h
+// Low-level reading and writing of binary game savefiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef BINFILE_H
+#define BINFILE_H
+
+#include <iostream>
+#include <string>
+
+#include "libgambit.h"
+
+namespace Gambit {
+
+//
+// A binary savefile starts with an eight-byte signature, whose first
+// byte cannot start a text savefile, followed by the integer 0x01020304
+// (which tells the byte order of the machine which wrote the file),
+// the version of the format, and the kind of game stored.  What follows
+// is up to the game representation.  Integers are 32 bits, and strings
+// are stored as their length followed by their bytes.
+//
+
+/// The version of the binary savefile format written
+const int BINARY_FILE_VERSION = 1;
+
+/// The kinds of game stored in binary savefiles
+enum BinaryGameKind { BINARY_GAME_TABLE = 1, BINARY_GAME_TREE = 2 };
+
+/// Returns true if the stream starts with a binary savefile,
+/// without consuming anything from it
+bool IsBinaryGameFile(std::istream &);
+
+/// Writes the data of a binary savefile to a stream
+class BinaryGameWriter {
+private:
+  std::ostream &m_file;
+
+public:
+  /// Writes the header for a game of kind p_kind
+  BinaryGameWriter(std::ostream &p_file, BinaryGameKind p_kind);
+
+  void WriteInt(int p_value);
+  void WriteInts(const int *p_values, long p_count);
+  void WriteString(const std::string &p_value);
+};
+
+/// Reads the data of a binary savefile from a stream.  Reading past the
+/// end of the file, or finding a value out of its range, throws
+/// InvalidFileException.
+class BinaryGameReader {
+private:
+  std::istream &m_file;
+  bool m_swapBytes;
+  BinaryGameKind m_kind;
+
+public:
+  /// Reads and checks the header of the savefile
+  BinaryGameReader(std::istream &p_file);
+
+  /// Returns the kind of game stored in the savefile
+  BinaryGameKind GetKind(void) const { return m_kind; }
+
+  int ReadInt(void);
+  /// Reads an integer, which must lie between p_min and p_max
+  int ReadInt(int p_min, int p_max);
+  void ReadInts(int *p_values, long p_count);
+  std::string ReadString(void);
+};
+
+} // end namespace Gambit
+
+#endif // BINFILE_H
@@ -22,11 +22,17 @@
 
 #include <cstdlib>
 #include <cctype>
+#include <climits>
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <algorithm>
 
 #include "libgambit.h"
+#include "gametable.h"
+#include "gametree.h"
+#include "binfile.h"
 
 namespace {
 // This anonymous namespace encapsulates the file-parsing code
@@ -66,6 +72,7 @@ public:
   int GetCurrentColumn(void) const { return m_currentColumn; }
   const char* CreateLineMsg(std::string msg);
   const std::string &GetLastText(void) const { return m_lastText; }
+  std::istream &GetFile(void) const { return m_file; }
 };
 
 void GameParserState::ReadChar(char& c)
@@ -600,24 +607,212 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
   }
 }
 
-void ParsePayoffBody(GameParserState &p_parser, GameRep *p_nfg)
+//!
+//! Reads the payoffs in the body of an .nfg file which gives payoffs
+//! inline.  Such files can be very large, so rather than going through
+//! the tokenizer a character at a time, this reads the stream in large
+//! blocks, and hands out each whitespace-delimited token in place.
+//!
+class PayoffScanner {
+private:
+  std::istream &m_file;
+  std::vector<char> m_buffer;
+  size_t m_pos, m_end;
+  int m_line;
+
+  /// Refill the buffer after its first p_keep characters
+  bool Fill(size_t p_keep);
+
+public:
+  PayoffScanner(std::istream &p_file, int p_line)
+    : m_file(p_file), m_buffer(1 << 16), m_pos(0), m_end(0), 
+      m_line(p_line) { }
+
+  /// Finds the next token; returns false at end of file
+  bool GetNextToken(const char *&p_begin, const char *&p_end);
+  std::string CreateLineMsg(const std::string &p_msg) const;
+};
+
+bool PayoffScanner::Fill(size_t p_keep)
 {
-  StrategyIterator iter(StrategySupport(static_cast<GameRep *>(p_nfg)));
-  int pl = 1;
+  if (p_keep == m_buffer.size()) {
+    m_buffer.resize(2 * m_buffer.size());
+  }
+  m_end = p_keep + m_file.rdbuf()->sgetn(&m_buffer[p_keep], 
+					 m_buffer.size() - p_keep);
+  return (m_end > p_keep);
+}
 
-  while (p_parser.GetCurrentToken() != TOKEN_EOF) {
-    if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-      (*iter)->GetOutcome()->SetPayoff(pl, p_parser.GetLastText());
+bool PayoffScanner::GetNextToken(const char *&p_begin, const char *&p_end)
+{
+  while (true) {
+    while (m_pos < m_end && isspace((unsigned char) m_buffer[m_pos])) {
+      if (m_buffer[m_pos++] == '\n') {
+	m_line++;
+      }
     }
-    else {
-      throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
+    if (m_pos < m_end) {
+      break;
     }
+    m_pos = 0;
+    if (!Fill(0)) {
+      return false;
+    }
+  }
 
-    if (++pl > p_nfg->NumPlayers()) {
-      iter++;
-      pl = 1;
+  size_t start = m_pos;
+  while (true) {
+    while (m_pos < m_end && !isspace((unsigned char) m_buffer[m_pos])) {
+      m_pos++;
     }
-    p_parser.GetNextToken();
+    if (m_pos < m_end) {
+      break;
+    }
+    // The token runs to the end of the buffer; move it to the front,
+    // and read more after it
+    std::copy(m_buffer.begin() + start, m_buffer.begin() + m_pos,
+	      m_buffer.begin());
+    m_pos -= start;
+    start = 0;
+    if (!Fill(m_pos)) {
+      break;
+    }
+  }
+
+  p_begin = &m_buffer[0] + start;
+  p_end = &m_buffer[0] + m_pos;
+  return true;
+}
+
+std::string PayoffScanner::CreateLineMsg(const std::string &p_msg) const
+{
+  std::ostringstream stream;
+  stream << "line " << m_line << ": " << p_msg;
+  return stream.str();
+}
+
+/// Scans at least one decimal digit, failing if the value overflows
+bool ScanDigits(const char *&p_pos, const char *p_end, 
+		int &p_value, int &p_count)
+{
+  p_value = 0;
+  for (p_count = 0; p_pos < p_end && isdigit((unsigned char) *p_pos);
+       p_pos++, p_count++) {
+    int digit = *p_pos - '0';
+    if (p_value > (INT_MAX - digit) / 10) {
+      return false;
+    }
+    p_value = 10 * p_value + digit;
+  }
+  return (p_count > 0);
+}
+
+//
+// Scans a payoff written as an integer, a fraction, or a decimal, whose
+// digits fit in an int.  Anything else, including numbers 
+// whose text would not come back the same (such as "-0" or "007"), is
+// refused, and left to the general parser.
+//
+bool ScanCompactNumber(const char *p_pos, const char *p_end,
+		       CompactNumber &p_value)
+{
+  bool negative = (p_pos < p_end && *p_pos == '-');
+  if (negative) {
+    p_pos++;
+  }
+  const char *digits = p_pos;
+  int value, count;
+  if (!ScanDigits(p_pos, p_end, value, count) || 
+      (count > 1 && *digits == '0')) {
+    return false;
+  }
+
+  if (p_pos == p_end) {
+    if (negative && value == 0) {
+      return false;
+    }
+    p_value = CompactNumber((negative) ? -value : value, 1);
+    return true;
+  }
+  else if (*p_pos == '/') {
+    digits = ++p_pos;
+    int denominator;
+    if (!ScanDigits(p_pos, p_end, denominator, count) || p_pos != p_end ||
+	denominator == 0 || (count > 1 && *digits == '0') ||
+	(negative && value == 0)) {
+      return false;
+    }
+    p_value = CompactNumber((negative) ? -value : value, denominator);
+    return true;
+  }
+  else if (*p_pos == '.') {
+    int fraction, decimals;
+    if (!ScanDigits(++p_pos, p_end, fraction, decimals) || p_pos != p_end) {
+      return false;
+    }
+    int scale = 1;
+    for (int i = 1; i <= decimals; i++) {
+      if (scale > INT_MAX / 10) {
+	return false;
+      }
+      scale *= 10;
+    }
+    if (value > (INT_MAX - fraction) / scale) {
+      return false;
+    }
+    int mantissa = value * scale + fraction;
+    if (negative && mantissa == 0) {
+      return false;
+    }
+    p_value = CompactNumber((negative) ? -mantissa : mantissa, 
+			    scale, decimals);
+    return true;
+  }
+  return false;
+}
+
+//
+// Payoffs are kept in compact form in the table, without creating any
+// outcomes.  Should a payoff not fit the compact form, the outcomes are
+// created at that point, and the rest of the payoffs are set on them.
+//
+void ParsePayoffBody(GameParserState &p_parser, GameTableRep *p_nfg)
+{
+  int nplayers = p_nfg->NumPlayers();
+  long size = (long) p_nfg->NumStrategyContingencies() * nplayers;
+  std::vector<CompactNumber> payoffs(size);
+  bool compact = true;
+
+  PayoffScanner scanner(p_parser.GetFile(), p_parser.GetCurrentLine());
+  std::string first = p_parser.GetLastText();
+  const char *begin = first.c_str(), *end = begin + first.length();
+  long index = 0;
+  do {
+    if (!isdigit((unsigned char) *begin) && 
+	*begin != '-' && *begin != '+' && *begin != '.') {
+      throw InvalidFileException(
+        scanner.CreateLineMsg("Expecting payoff").c_str());
+    }
+    if (index >= size) {
+      throw InvalidFileException(
+	scanner.CreateLineMsg("More payoffs than contingencies").c_str());
+    }
+
+    if (compact && ScanCompactNumber(begin, end, payoffs[index])) {
+      index++;
+      continue;
+    }
+    if (compact) {
+      p_nfg->SetInlinePayoffs(payoffs);
+      compact = false;
+    }
+    p_nfg->GetOutcome(index / nplayers + 1)->SetPayoff(index % nplayers + 1,
+						       std::string(begin, end));
+    index++;
+  } while (scanner.GetNextToken(begin, end));
+
+  if (compact) {
+    p_nfg->SetInlinePayoffs(payoffs);
   }
 }
 
@@ -628,7 +823,9 @@ Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data)
     dim[pl] = p_data.NumStrategies(pl);
   }
 
-  GameRep *nfg = NewTable(dim);
+  // Payoffs given inline are set without creating outcomes
+  bool inlinePayoffs = (p_parser.GetCurrentToken() == TOKEN_NUMBER);
+  GameTableRep *nfg = new GameTableRep(dim, inlinePayoffs);
   // Assigning this to the container assures that, if something goes
   // wrong, the class will automatically be cleaned up
   Game game = nfg;
@@ -646,7 +843,7 @@ Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data)
   if (p_parser.GetCurrentToken() == TOKEN_LBRACE) {
     ParseOutcomeBody(p_parser, nfg);
   }
-  else if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
+  else if (inlinePayoffs) {
     ParsePayoffBody(p_parser, nfg);
   }
   else {
@@ -997,11 +1194,26 @@ void ParseEfg(GameParserState &p_state, Game p_game, TreeData &p_treeData)
 namespace Gambit {
 
 //=========================================================================
-//    ReadGame: Global visible function to read an .efg or .nfg file
+//    ReadGame: Global visible function to read any kind of game file
 //=========================================================================
 
 Game ReadGame(std::istream &p_file) throw (InvalidFileException)
 {
+  if (IsBinaryGameFile(p_file)) {
+    try {
+      BinaryGameReader reader(p_file);
+      if (reader.GetKind() == BINARY_GAME_TABLE) {
+	return GameTableRep::ReadBinaryFile(reader);
+      }
+      else {
+	return GameTreeRep::ReadBinaryFile(reader);
+      }
+    }
+    catch (const std::exception &ex) {
+      throw InvalidFileException(ex.what());
+    }
+  }
+
   GameParserState parser(p_file);
 
   try {
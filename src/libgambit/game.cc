@@ -22,10 +22,13 @@
 
 #include <iostream>
 #include <sstream>
+#include <climits>
+#include <vector>
 
 #include "libgambit.h"
 #include "gametree.h"
 #include "gametable.h"
+#include "binfile.h"
 
 namespace Gambit {
 
@@ -510,10 +513,51 @@ void GameExplicitRep::Write(std::ostream &p_stream,
 	   (p_format == "native" && !IsTree())) {
     WriteNfgFile(p_stream);
   }
+  else if (p_format == "binary") {
+    WriteBinaryFile(p_stream);
+  }
   else {
     throw UndefinedException();
   }
 }
 
+void GameExplicitRep::WriteBinaryOutcomes(BinaryGameWriter &p_writer) const
+{
+  p_writer.WriteInt(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    p_writer.WriteString(m_outcomes[outc]->m_label);
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      p_writer.WriteString(m_outcomes[outc]->m_payoffs[pl]);
+    }
+  }
+}
+
+void GameExplicitRep::ReadBinaryOutcomes(BinaryGameReader &p_reader)
+{
+  // The outcomes are collected before being put in the game, since
+  // appending them one at a time takes quadratic time
+  int noutcomes = p_reader.ReadInt(0, INT_MAX);
+  std::vector<GameOutcomeRep *> outcomes;
+  try {
+    for (int outc = 1; outc <= noutcomes; outc++) {
+      outcomes.push_back(new GameOutcomeRep(this, outc));
+      outcomes.back()->m_label = p_reader.ReadString();
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	outcomes.back()->m_payoffs[pl] = p_reader.ReadString();
+      }
+    }
+  }
+  catch (...) {
+    for (size_t i = 0; i < outcomes.size(); outcomes[i++]->Invalidate());
+    throw;
+  }
+
+  m_outcomes = Array<GameOutcomeRep *>(noutcomes);
+  for (int outc = 1; outc <= noutcomes; outc++) {
+    m_outcomes[outc] = outcomes[outc - 1];
+  }
+  ClearComputedValues();
+}
+
 
 }  // end namespace Gambit
@@ -269,11 +269,7 @@ public:
   template <class T> const T &GetPayoff(int pl) const 
     { return (const T &) m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
   //@}
 };
 
@@ -405,6 +401,7 @@ class GamePlayerRep : public GameObject {
   friend class GameTreeInfosetRep;
   friend class GameStrategyRep;
   friend class GameTreeNodeRep;
+  friend class TablePureStrategyProfileRep;
   template <class T> friend class MixedBehavProfile;
   template <class T> friend class MixedStrategyProfile;
 
@@ -554,7 +551,7 @@ public:
   virtual Rational GetStrategyValue(const GameStrategy &) const = 0;
 
   /// Is the profile a pure strategy Nash equilibrium?
-  bool IsNash(void) const;
+  virtual bool IsNash(void) const;
 
   /// Is the profile a strict pure stategy Nash equilibrium?
   bool IsStrictNash(void) const;
@@ -636,6 +633,7 @@ public:
 
 /// This is the class for representing an arbitrary finite game.
 class GameRep : public GameObject {
+  friend class GameOutcomeRep;
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -656,6 +654,8 @@ protected:
   virtual void Canonicalize(void) { }  
   /// Clear out any computed values
   virtual void ClearComputedValues(void) const { }
+  /// Clear out any values computed from the payoffs of outcomes
+  virtual void ClearComputedPayoffs(void) const { }
   /// Build any computed values anew
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
@@ -797,6 +797,11 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->ClearComputedPayoffs();
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
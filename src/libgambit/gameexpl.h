@@ -27,6 +27,9 @@
 
 namespace Gambit {
 
+class BinaryGameReader;
+class BinaryGameWriter;
+
 class GameExplicitRep : public GameRep {
   template <class T> friend class MixedStrategyProfile;
 protected:
@@ -41,6 +44,14 @@ protected:
   /// Write the game in .nfg format to the specified stream
   virtual void WriteNfgFile(std::ostream &) const
   { throw UndefinedException(); }
+  /// Write the game in binary format to the specified stream
+  virtual void WriteBinaryFile(std::ostream &) const
+  { throw UndefinedException(); }
+  /// Write the labels and payoffs of the outcomes to a binary savefile
+  void WriteBinaryOutcomes(BinaryGameWriter &) const;
+  /// Read outcomes written by WriteBinaryOutcomes into a game which
+  /// has none yet
+  void ReadBinaryOutcomes(BinaryGameReader &);
   //@}
 
 public:
@@ -22,9 +22,12 @@
 
 #include <iostream>
 #include <sstream>
+#include <climits>
+#include <algorithm>
 
 #include "libgambit.h"
 #include "gametable.h"
+#include "binfile.h"
 
 namespace Gambit {
 
@@ -34,26 +37,31 @@ namespace Gambit {
 
 class TablePureStrategyProfileRep : public PureStrategyProfileRep {
 protected:
+  /// The game on which the profile is defined, bound on construction
+  GameTableRep *m_table;
   long m_index;
 
   virtual PureStrategyProfileRep *Copy(void) const;
 
 public:
-  TablePureStrategyProfileRep(const Game &p_game);
+  TablePureStrategyProfileRep(GameTableRep *p_game);
   virtual long GetIndex(void) const { return m_index; }
   virtual void SetStrategy(const GameStrategy &);
   virtual GameOutcome GetOutcome(void) const;
   virtual void SetOutcome(GameOutcome p_outcome);
   virtual Rational GetPayoff(int pl) const;
   virtual Rational GetStrategyValue(const GameStrategy &) const;
+  virtual bool IsNash(void) const;
 };
 
 //------------------------------------------------------------------------
 //               TablePureStrategyProfileRep: Lifecycle
 //------------------------------------------------------------------------
 
-TablePureStrategyProfileRep::TablePureStrategyProfileRep(const Game &p_nfg)
+TablePureStrategyProfileRep::TablePureStrategyProfileRep(GameTableRep *p_nfg)
+  : m_table(p_nfg)
 {
+  m_table->BuildOutcomes();
   m_index = 1L;
   m_nfg = p_nfg;
   m_profile = Array<GameStrategy>(m_nfg->NumPlayers());
@@ -85,17 +93,18 @@ void TablePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 
 GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 { 
-  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index]; 
+  return m_table->m_results[m_index]; 
 }
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  m_table->m_results[m_index] = p_outcome; 
+  m_table->ClearComputedValues();
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
 {
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index];
+  GameOutcomeRep *outcome = m_table->m_results[m_index];
   if (outcome) {
     return outcome->GetPayoff<Rational>(pl);
   }
@@ -108,7 +117,7 @@ Rational
 TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
+  GameOutcomeRep *outcome = m_table->m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
   if (outcome) {
     return outcome->GetPayoff<Rational>(player);
   }
@@ -117,6 +126,38 @@ TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) co
   }
 }
 
+namespace {
+
+/// The payoff to player pl of the outcome, which may be null
+inline const Rational &OutcomePayoff(const GameOutcomeRep *p_outcome, int pl)
+{
+  static const Rational zero(0);
+  return (p_outcome) ? p_outcome->GetPayoff<Rational>(pl) : zero;
+}
+
+}  // end anonymous namespace
+
+//
+// This reads the payoffs straight from the table, comparing them in
+// place, rather than computing the value of each strategy in turn.
+//
+bool TablePureStrategyProfileRep::IsNash(void) const
+{
+  for (int pl = 1; pl <= m_profile.Length(); pl++) {
+    GameStrategyRep *current = m_profile[pl];
+    const Rational &payoff = OutcomePayoff(m_table->m_results[m_index], pl);
+    long base = m_index - current->m_offset;
+    const Array<GameStrategyRep *> &strategies = current->m_player->m_strategies;
+    for (int st = 1; st <= strategies.Length(); st++) {
+      if (OutcomePayoff(m_table->m_results[base + strategies[st]->m_offset],
+			pl) > payoff) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
 PureStrategyProfile GameTableRep::NewPureStrategyProfile(void) const
 {
   return PureStrategyProfile(new TablePureStrategyProfileRep(const_cast<GameTableRep *>(this)));
@@ -169,10 +210,147 @@ GameTableRep::GameTableRep(const Array<int> &dim,
 
 Game GameTableRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteNfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  Array<int> dim(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    dim[pl] = m_players[pl]->m_strategies.Length();
+  }
+  GameTableRep *nfg = new GameTableRep(dim, true);
+  // Assigning this to the container assures that, if something goes
+  // wrong, the class will automatically be cleaned up
+  Game game = nfg;
+
+  nfg->SetTitle(GetTitle());
+  nfg->SetComment(GetComment());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    nfg->m_players[pl]->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= dim[pl]; st++) {
+      nfg->m_players[pl]->m_strategies[st]->m_label =
+	m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+
+  if (!m_inlinePayoffs.empty()) {
+    std::vector<CompactNumber> payoffs(m_inlinePayoffs);
+    nfg->SetInlinePayoffs(payoffs);
+    return game;
+  }
+
+  // Payoffs are copied as numbers, so nothing is formatted or parsed
+  nfg->m_outcomes = Array<GameOutcomeRep *>(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    nfg->m_outcomes[outc] = new GameOutcomeRep(nfg, outc);
+    nfg->m_outcomes[outc]->m_label = m_outcomes[outc]->m_label;
+    nfg->m_outcomes[outc]->m_payoffs = m_outcomes[outc]->m_payoffs;
+  }
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    nfg->m_results[cont] = (m_results[cont]) ?
+      nfg->m_outcomes[m_results[cont]->m_number] : 0;
+  }
+  return game;
+}
+
+namespace {
+
+/// The number of payoffs or contingencies read from a binary savefile
+/// at a time
+const int BINARY_BLOCK_SIZE = 1 << 16;
+
+/// How the contingencies of a table game are given in a binary savefile
+enum BinaryTableLayout {
+  /// The number of the outcome of each contingency, zero if none
+  BINARY_TABLE_OUTCOMES = 0,
+  /// The payoffs of each contingency, in the layout of the inline 
+  /// payoff table, as numerator, denominator, and number of decimals
+  BINARY_TABLE_PAYOFFS = 1,
+  /// As BINARY_TABLE_PAYOFFS, when all payoffs are integers, given
+  /// by their values alone
+  BINARY_TABLE_INTEGERS = 2
+};
+
+} // end anonymous namespace
+
+Game GameTableRep::ReadBinaryFile(BinaryGameReader &p_reader)
+{
+  std::string title = p_reader.ReadString();
+  std::string comment = p_reader.ReadString();
+
+  int nplayers = p_reader.ReadInt(1, INT_MAX);
+  Array<std::string> players(nplayers);
+  Array<Array<std::string> > strategies(nplayers);
+  Array<int> dim(nplayers);
+  long ncont = 1;
+  for (int pl = 1; pl <= nplayers; pl++) {
+    players[pl] = p_reader.ReadString();
+    dim[pl] = p_reader.ReadInt(1, INT_MAX);
+    if (ncont > INT_MAX / nplayers / dim[pl]) {
+      throw InvalidFileException("Binary game file has too many contingencies");
+    }
+    ncont *= dim[pl];
+    strategies[pl] = Array<std::string>(dim[pl]);
+    for (int st = 1; st <= dim[pl]; st++) {
+      strategies[pl][st] = p_reader.ReadString();
+    }
+  }
+
+  GameTableRep *nfg = new GameTableRep(dim, true);
+  // Assigning this to the container assures that, if something goes
+  // wrong, the class will automatically be cleaned up
+  Game game = nfg;
+
+  nfg->SetTitle(title);
+  nfg->SetComment(comment);
+  for (int pl = 1; pl <= nplayers; pl++) {
+    nfg->m_players[pl]->SetLabel(players[pl]);
+    for (int st = 1; st <= dim[pl]; st++) {
+      nfg->m_players[pl]->m_strategies[st]->SetLabel(strategies[pl][st]);
+    }
+  }
+
+  nfg->ReadBinaryOutcomes(p_reader);
+  int noutcomes = nfg->m_outcomes.Length();
+
+  int layout = p_reader.ReadInt(BINARY_TABLE_OUTCOMES, BINARY_TABLE_INTEGERS);
+  std::vector<int> block;
+  if (layout == BINARY_TABLE_OUTCOMES) {
+    for (long start = 0; start < ncont; start += BINARY_BLOCK_SIZE) {
+      int count = std::min(ncont - start, (long) BINARY_BLOCK_SIZE);
+      block.resize(count);
+      p_reader.ReadInts(&block[0], count);
+      for (int i = 0; i < count; i++) {
+	if (block[i] < 0 || block[i] > noutcomes) {
+	  throw InvalidFileException("Invalid outcome in binary game file");
+	}
+	nfg->m_results[start + i + 1] = 
+	  (block[i] > 0) ? nfg->m_outcomes[block[i]] : 0;
+      }
+    }
+    return game;
+  }
+
+  if (noutcomes > 0) {
+    throw InvalidFileException("Binary game file has outcomes and payoffs");
+  }
+  int width = (layout == BINARY_TABLE_PAYOFFS) ? 3 : 1;
+  long npayoffs = ncont * nplayers;
+  std::vector<CompactNumber> payoffs(npayoffs);
+  for (long start = 0; start < npayoffs; start += BINARY_BLOCK_SIZE) {
+    int count = std::min(npayoffs - start, (long) BINARY_BLOCK_SIZE);
+    block.resize(width * count);
+    p_reader.ReadInts(&block[0], width * count);
+    for (int i = 0; i < count; i++) {
+      if (width == 1) {
+	payoffs[start + i] = CompactNumber(block[i], 1);
+	continue;
+      }
+      int denominator = block[3*i+1], decimals = block[3*i+2];
+      if (denominator <= 0 || decimals < 0 || decimals > 9) {
+	throw InvalidFileException("Invalid payoff in binary game file");
+      }
+      payoffs[start + i] = CompactNumber(block[3*i], denominator, decimals);
+    }
+  }
+  nfg->SetInlinePayoffs(payoffs);
+  return game;
 }
 
 //------------------------------------------------------------------------
@@ -203,6 +381,46 @@ bool GameTableRep::IsConstSum(void) const
   return true;
 }
 
+Rational GameTableRep::GetMinPayoff(int player) const
+{
+  if (m_inlinePayoffs.empty()) {
+    return GameExplicitRep::GetMinPayoff(player);
+  }
+
+  int nplayers = m_players.Length();
+  int p1 = (player) ? player : 1, p2 = (player) ? player : nplayers;
+  Rational minpay = m_inlinePayoffs[p1 - 1];
+  for (size_t index = 0; index < m_inlinePayoffs.size(); index += nplayers) {
+    for (int pl = p1; pl <= p2; pl++) {
+      Rational payoff = m_inlinePayoffs[index + pl - 1];
+      if (payoff < minpay) {
+	minpay = payoff;
+      }
+    }
+  }
+  return minpay;
+}
+
+Rational GameTableRep::GetMaxPayoff(int player) const
+{
+  if (m_inlinePayoffs.empty()) {
+    return GameExplicitRep::GetMaxPayoff(player);
+  }
+
+  int nplayers = m_players.Length();
+  int p1 = (player) ? player : 1, p2 = (player) ? player : nplayers;
+  Rational maxpay = m_inlinePayoffs[p1 - 1];
+  for (size_t index = 0; index < m_inlinePayoffs.size(); index += nplayers) {
+    for (int pl = p1; pl <= p2; pl++) {
+      Rational payoff = m_inlinePayoffs[index + pl - 1];
+      if (payoff > maxpay) {
+	maxpay = payoff;
+      }
+    }
+  }
+  return maxpay;
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Writing data files
 //------------------------------------------------------------------------
@@ -225,6 +443,7 @@ std::string EscapeQuotes(const std::string &s)
 
 void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 { 
+  BuildOutcomes();
   p_file << "NFG 1 R";
   p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
 
@@ -278,12 +497,74 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   p_file << '\n';
 }
 
+void GameTableRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryGameWriter writer(p_file, BINARY_GAME_TABLE);
+  writer.WriteString(GetTitle());
+  writer.WriteString(GetComment());
+
+  writer.WriteInt(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    writer.WriteString(player->m_label);
+    writer.WriteInt(player->m_strategies.Length());
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      writer.WriteString(player->m_strategies[st]->m_label);
+    }
+  }
+
+  WriteBinaryOutcomes(writer);
+
+  std::vector<int> block;
+  if (m_inlinePayoffs.empty()) {
+    writer.WriteInt(BINARY_TABLE_OUTCOMES);
+    long ncont = m_results.Length();
+    for (long start = 0; start < ncont; start += BINARY_BLOCK_SIZE) {
+      int count = std::min(ncont - start, (long) BINARY_BLOCK_SIZE);
+      block.resize(count);
+      for (int i = 0; i < count; i++) {
+	GameOutcomeRep *outcome = m_results[start + i + 1];
+	block[i] = (outcome) ? outcome->m_number : 0;
+      }
+      writer.WriteInts(&block[0], count);
+    }
+    return;
+  }
+
+  int width = 1;
+  for (size_t i = 0; i < m_inlinePayoffs.size(); i++) {
+    if (m_inlinePayoffs[i].GetDenominator() != 1) {
+      width = 3;
+      break;
+    }
+  }
+  writer.WriteInt((width == 1) ? BINARY_TABLE_INTEGERS : BINARY_TABLE_PAYOFFS);
+  long npayoffs = m_inlinePayoffs.size();
+  for (long start = 0; start < npayoffs; start += BINARY_BLOCK_SIZE) {
+    int count = std::min(npayoffs - start, (long) BINARY_BLOCK_SIZE);
+    block.resize(width * count);
+    for (int i = 0; i < count; i++) {
+      const CompactNumber &payoff = m_inlinePayoffs[start + i];
+      if (width == 1) {
+	block[i] = payoff.GetNumerator();
+      }
+      else {
+	block[3*i] = payoff.GetNumerator();
+	block[3*i+1] = payoff.GetDenominator();
+	block[3*i+2] = payoff.GetDecimals();
+      }
+    }
+    writer.WriteInts(&block[0], width * count);
+  }
+}
+
 //------------------------------------------------------------------------
 //                       GameTableRep: Players
 //------------------------------------------------------------------------
 
 GamePlayer GameTableRep::NewPlayer(void)
 {
+  BuildOutcomes();
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1, 1);
   m_players.Append(player);
@@ -298,8 +579,55 @@ GamePlayer GameTableRep::NewPlayer(void)
 //                        GameTableRep: Outcomes
 //------------------------------------------------------------------------
 
+void GameTableRep::SetInlinePayoffs(std::vector<CompactNumber> &p_payoffs)
+{
+  m_inlinePayoffs.swap(p_payoffs);
+  m_inlinePayoffs.resize(m_results.Length() * m_players.Length());
+  ClearComputedPayoffs();
+}
+
+void GameTableRep::BuildOutcomes(void) const
+{
+  if (m_inlinePayoffs.empty()) {
+    return;
+  }
+
+  GameTableRep *game = const_cast<GameTableRep *>(this);
+  int nplayers = m_players.Length();
+  game->m_outcomes = Array<GameOutcomeRep *>(m_results.Length());
+  for (int i = 1; i <= m_outcomes.Length(); i++) {
+    GameOutcomeRep *outcome = new GameOutcomeRep(game, i);
+    for (int pl = 1; pl <= nplayers; pl++) {
+      outcome->m_payoffs[pl] = 
+	m_inlinePayoffs[(i - 1) * nplayers + pl - 1].GetText();
+    }
+    game->m_outcomes[i] = outcome;
+  }
+  game->m_results = m_outcomes;
+  std::vector<CompactNumber>().swap(game->m_inlinePayoffs);
+}
+
+int GameTableRep::NumOutcomes(void) const
+{
+  BuildOutcomes();
+  return m_outcomes.Length();
+}
+
+GameOutcome GameTableRep::GetOutcome(int index) const
+{
+  BuildOutcomes();
+  return m_outcomes[index];
+}
+
+GameOutcome GameTableRep::NewOutcome(void)
+{
+  BuildOutcomes();
+  return GameExplicitRep::NewOutcome();
+}
+
 void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
+  BuildOutcomes();
   for (int i = 1; i <= m_results.Length(); i++) {
     if (m_results[i] == p_outcome) {
       m_results[i] = 0;
@@ -312,6 +640,66 @@ void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
   ClearComputedValues();
 }
 
+//------------------------------------------------------------------------
+//                  GameTableRep: Dense payoff tables
+//------------------------------------------------------------------------
+
+template <class T>
+void GameTableRep::BuildPayoffTable(std::vector<T> &p_table) const
+{
+  long ncont = m_results.Length();
+  int nplayers = m_players.Length();
+  p_table.assign(nplayers * ncont, (T) 0);
+  if (!m_inlinePayoffs.empty()) {
+    for (long cont = 0; cont < ncont; cont++) {
+      for (int pl = 0; pl < nplayers; pl++) {
+	T payoff = m_inlinePayoffs[cont * nplayers + pl];
+	p_table[pl * ncont + cont] = payoff;
+      }
+    }
+    return;
+  }
+  for (long cont = 1; cont <= ncont; cont++) {
+    GameOutcomeRep *outcome = m_results[cont];
+    if (outcome) {
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	p_table[(pl - 1) * ncont + cont - 1] = outcome->GetPayoff<T>(pl);
+      }
+    }
+  }
+}
+
+template<> const double *GameTableRep::GetPayoffTable(int pl) const
+{
+  if (m_doublePayoffs.empty()) {
+    BuildPayoffTable(m_doublePayoffs);
+  }
+  return &m_doublePayoffs[(pl - 1) * m_results.Length()];
+}
+
+template<> const Rational *GameTableRep::GetPayoffTable(int pl) const
+{
+  if (m_rationalPayoffs.empty()) {
+    BuildPayoffTable(m_rationalPayoffs);
+  }
+  return &m_rationalPayoffs[(pl - 1) * m_results.Length()];
+}
+
+//------------------------------------------------------------------------
+//             GameTableRep: Managing the representation
+//------------------------------------------------------------------------
+
+void GameTableRep::ClearComputedValues(void) const
+{
+  ClearComputedPayoffs();
+}
+
+void GameTableRep::ClearComputedPayoffs(void) const
+{
+  m_doublePayoffs.clear();
+  m_rationalPayoffs.clear();
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Factory functions
 //------------------------------------------------------------------------
@@ -344,6 +732,7 @@ MixedStrategyProfile<Rational> GameTableRep::NewMixedStrategyProfile(const Ratio
 /// numbered -1 are identified as the new strategies.
 void GameTableRep::RebuildTable(void)
 {
+  BuildOutcomes();
   long size = 1L;
   Array<long> offsets(m_players.Length());
   for (int pl = 1; pl <= m_players.Length(); pl++) {
@@ -376,6 +765,7 @@ void GameTableRep::RebuildTable(void)
   m_results = newResults;
 
   IndexStrategies();
+  ClearComputedValues();
 }
 
 void GameTableRep::IndexStrategies(void)
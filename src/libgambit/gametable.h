@@ -23,6 +23,7 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -34,10 +35,33 @@ class GameTableRep : public GameExplicitRep {
 private:
   Array<GameOutcomeRep *> m_results;
 
+  /// @name Dense payoff tables
+  //@{
+  /// Payoffs in floating point, one contiguous block per player
+  mutable std::vector<double> m_doublePayoffs;
+  /// Payoffs in exact arithmetic, one contiguous block per player
+  mutable std::vector<Rational> m_rationalPayoffs;
+  //@}
+
+  /// Payoffs given without outcomes, each contingency's together; 
+  /// empty once the outcomes have been created
+  std::vector<CompactNumber> m_inlinePayoffs;
+
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  /// Create an outcome for each contingency with inline payoffs
+  void BuildOutcomes(void) const;
+  /// Fill the dense payoff table with the outcome payoffs
+  template <class T> void BuildPayoffTable(std::vector<T> &) const;
+  //@}
+
+protected:
+  /// @name Managing the representation
+  //@{
+  virtual void ClearComputedValues(void) const;
+  virtual void ClearComputedPayoffs(void) const;
   //@}
 
 public:
@@ -47,6 +71,8 @@ public:
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
   GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
   virtual Game Copy(void) const;
+  /// Build a game from the rest of a binary savefile
+  static Game ReadBinaryFile(BinaryGameReader &);
   //@}
 
   /// @name General data access
@@ -55,6 +81,8 @@ public:
   virtual bool IsConstSum(void) const;
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
+  virtual Rational GetMinPayoff(int pl = 0) const;
+  virtual Rational GetMaxPayoff(int pl = 0) const;
   //@}
 
   /// @name Dimensions of the game
@@ -101,13 +129,39 @@ public:
 
   /// @name Outcomes
   //@{
+  virtual int NumOutcomes(void) const;
+  virtual GameOutcome GetOutcome(int index) const;
+  virtual GameOutcome NewOutcome(void);
   /// Deletes the specified outcome from the game
   virtual void DeleteOutcome(const GameOutcome &);
+  /// \brief Sets the payoffs of all contingencies without outcomes
+  ///
+  /// Sets the payoffs of all contingencies, with each contingency's
+  /// payoffs to the players together, in the order of the table.  The
+  /// game must have no outcomes; the contents of p_payoffs are taken
+  /// over.  An outcome for each contingency, numbered as the 
+  /// contingencies, is created only once the outcomes or pure strategy
+  /// profiles of the game are used, so games used only through mixed
+  /// profiles are stored in little more than the space of the payoffs.
+  void SetInlinePayoffs(std::vector<CompactNumber> &p_payoffs);
+  //@}
+
+  /// @name Dense payoff tables
+  //@{
+  /// \brief Returns the payoffs to player pl for all contingencies
+  ///
+  /// Returns a pointer to the payoffs to player pl, indexed by
+  /// contingency (zero-based, i.e., the sum of the strategy offsets).
+  /// Contingencies with no outcome have payoff zero.  The table is built
+  /// on first use, and remains valid until the computed values of
+  /// the game are cleared.
+  template <class T> const T *GetPayoffTable(int pl) const;
   //@}
 
   /// @name Writing data files
   //@{
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
@@ -118,6 +172,9 @@ public:
 
 };
 
+template<> const double *GameTableRep::GetPayoffTable(int pl) const;
+template<> const Rational *GameTableRep::GetPayoffTable(int pl) const;
+
 }
 
 
@@ -22,9 +22,13 @@
 
 #include <iostream>
 #include <sstream>
+#include <climits>
+#include <vector>
+#include <map>
 
 #include "libgambit.h"
 #include "gametree.h"
+#include "binfile.h"
 
 namespace Gambit {
 
@@ -433,10 +437,7 @@ void GameTreeNodeRep::MoveTree(GameNode p_src)
 
 Game GameTreeNodeRep::CopySubgame(void) const
 {
-  std::ostringstream os;
-  m_efg->WriteEfgFile(os, const_cast<GameTreeNodeRep *>(this));
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  return m_efg->CopyGame(this);
 }
 
 void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
@@ -548,6 +549,7 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 //------------------------------------------------------------------------
 
 GameTreeRep::GameTreeRep(void)
+  : m_flatTree(0)
 {
   m_computedValues = false;
   m_chance = new GamePlayerRep(this, 0);
@@ -558,14 +560,225 @@ GameTreeRep::~GameTreeRep()
 {
   m_root->Invalidate();
   m_chance->Invalidate();
+  delete m_flatTree;
 }
 
 Game GameTreeRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteEfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  return CopyGame(m_root);
+}
+
+Game GameTreeRep::CopyGame(const GameTreeNodeRep *p_root) const
+{
+  GameTreeRep *efg = new GameTreeRep();
+  // Assigning this to the container assures that, if something goes
+  // wrong, the class will automatically be cleaned up
+  Game game = efg;
+
+  efg->SetTitle(GetTitle());
+  efg->SetComment(GetComment());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = new GamePlayerRep(efg, pl);
+    efg->m_players.Append(player);
+    player->m_label = m_players[pl]->m_label;
+  }
+
+  // A copy of the whole tree has all the information sets and outcomes,
+  // even those not reached, in their order in this game.  A copy of a
+  // subtree has only those reached in it, numbered in the order first
+  // reached, as when the subtree is written out and read back.
+  std::vector<GameTreeInfosetRep *> infosetOrder;
+  std::vector<int> outcomeOrder;
+  std::map<const GameTreeInfosetRep *, GameTreeInfosetRep *> infosets;
+  if (p_root == m_root) {
+    for (int pl = 0; pl <= m_players.Length(); pl++) {
+      GamePlayerRep *player = (pl > 0) ? m_players[pl] : m_chance;
+      for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+	infosetOrder.push_back(player->m_infosets[iset]);
+      }
+    }
+    for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+      outcomeOrder.push_back(outc);
+    }
+  }
+  else {
+    std::vector<bool> reached(m_outcomes.Length() + 1, false);
+    std::vector<const GameTreeNodeRep *> pending(1, p_root);
+    while (!pending.empty()) {
+      const GameTreeNodeRep *node = pending.back();
+      pending.pop_back();
+      if (node->outcome && !reached[node->outcome->m_number]) {
+	reached[node->outcome->m_number] = true;
+	outcomeOrder.push_back(node->outcome->m_number);
+      }
+      if (node->infoset && !infosets.count(node->infoset)) {
+	infosets[node->infoset] = 0;
+	infosetOrder.push_back(node->infoset);
+      }
+      for (int act = node->children.Length(); act >= 1; act--) {
+	pending.push_back(node->children[act]);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < infosetOrder.size(); i++) {
+    GameTreeInfosetRep *infoset = infosetOrder[i];
+    int pl = infoset->m_player->m_number;
+    GamePlayerRep *player = (pl > 0) ? efg->m_players[pl] : efg->m_chance;
+    GameTreeInfosetRep *copy = 
+      new GameTreeInfosetRep(efg, player->m_infosets.Length() + 1,
+			     player, infoset->m_actions.Length());
+    copy->m_label = infoset->m_label;
+    for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+      copy->m_actions[act]->m_label = infoset->m_actions[act]->m_label;
+    }
+    if (pl == 0) {
+      copy->m_probs = infoset->m_probs;
+    }
+    infosets[infoset] = copy;
+  }
+
+  // Payoffs are copied as numbers, so nothing is formatted or parsed
+  std::vector<GameOutcomeRep *> outcomes(m_outcomes.Length() + 1,
+					(GameOutcomeRep *) 0);
+  efg->m_outcomes = Array<GameOutcomeRep *>(outcomeOrder.size());
+  for (int outc = 1; outc <= efg->m_outcomes.Length(); outc++) {
+    const GameOutcomeRep *outcome = m_outcomes[outcomeOrder[outc - 1]];
+    GameOutcomeRep *copy = new GameOutcomeRep(efg, outc);
+    copy->m_label = outcome->m_label;
+    copy->m_payoffs = outcome->m_payoffs;
+    efg->m_outcomes[outc] = outcomes[outcome->m_number] = copy;
+  }
+
+  // The nodes are copied in preorder, so members are added to their
+  // information sets in order
+  std::vector<std::pair<const GameTreeNodeRep *, GameTreeNodeRep *> > 
+    pending(1, std::make_pair(p_root, efg->m_root));
+  while (!pending.empty()) {
+    const GameTreeNodeRep *node = pending.back().first;
+    GameTreeNodeRep *copy = pending.back().second;
+    pending.pop_back();
+    copy->m_label = node->m_label;
+    copy->outcome = (node->outcome) ? outcomes[node->outcome->m_number] : 0;
+    if (!node->infoset) {
+      continue;
+    }
+    copy->infoset = infosets[node->infoset];
+    copy->infoset->AddMember(copy);
+    for (int act = 1; act <= node->children.Length(); act++) {
+      copy->children.Append(new GameTreeNodeRep(efg, copy));
+    }
+    for (int act = node->children.Length(); act >= 1; act--) {
+      pending.push_back(std::make_pair(node->children[act],
+				       copy->children[act]));
+    }
+  }
+
+  int index = 1;
+  efg->NumberNodes(efg->m_root, index);
+  return game;
+}
+
+Game GameTreeRep::ReadBinaryFile(BinaryGameReader &p_reader)
+{
+  GameTreeRep *efg = new GameTreeRep();
+  // Assigning this to the container assures that, if something goes
+  // wrong, the class will automatically be cleaned up
+  Game game = efg;
+
+  efg->SetTitle(p_reader.ReadString());
+  efg->SetComment(p_reader.ReadString());
+
+  int nplayers = p_reader.ReadInt(0, INT_MAX);
+  for (int pl = 0; pl <= nplayers; pl++) {
+    GamePlayerRep *player = efg->m_chance;
+    if (pl > 0) {
+      player = new GamePlayerRep(efg, pl);
+      efg->m_players.Append(player);
+      player->m_label = p_reader.ReadString();
+    }
+    int ninfosets = p_reader.ReadInt(0, INT_MAX);
+    for (int iset = 1; iset <= ninfosets; iset++) {
+      std::string label = p_reader.ReadString();
+      GameTreeInfosetRep *infoset = 
+	new GameTreeInfosetRep(efg, iset, player, p_reader.ReadInt(1, INT_MAX));
+      infoset->m_label = label;
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	infoset->m_actions[act]->m_label = p_reader.ReadString();
+	if (pl == 0) {
+	  infoset->m_probs[act] = p_reader.ReadString();
+	}
+      }
+    }
+  }
+
+  efg->ReadBinaryOutcomes(p_reader);
+  int noutcomes = efg->m_outcomes.Length();
+
+  // The nodes are given in preorder, by their labels, and then by
+  // the player, information set, and outcome at each.  Terminal nodes
+  // have player -1; the chance player is 0.
+  int nnodes = p_reader.ReadInt(1, INT_MAX / 3);
+  std::vector<std::string> labels;
+  for (int i = 0; i < nnodes; i++) {
+    labels.push_back(p_reader.ReadString());
+  }
+  std::vector<int> data(3 * nnodes);
+  p_reader.ReadInts(&data[0], 3 * nnodes);
+
+  std::vector<GameTreeNodeRep *> pending(1, efg->m_root);
+  for (int i = 0; i < nnodes; i++) {
+    if (pending.empty()) {
+      throw InvalidFileException("Too many nodes in binary game file");
+    }
+    GameTreeNodeRep *node = pending.back();
+    pending.pop_back();
+    node->m_label = labels[i];
+
+    int pl = data[3*i], iset = data[3*i+1], outc = data[3*i+2];
+    if (outc < 0 || outc > noutcomes) {
+      throw InvalidFileException("Invalid outcome in binary game file");
+    }
+    node->outcome = (outc > 0) ? efg->m_outcomes[outc] : 0;
+    if (pl == -1) {
+      continue;
+    }
+    if (pl < 0 || pl > nplayers) {
+      throw InvalidFileException("Invalid player in binary game file");
+    }
+    GamePlayerRep *player = (pl > 0) ? efg->m_players[pl] : efg->m_chance;
+    if (iset < 1 || iset > player->m_infosets.Length()) {
+      throw InvalidFileException("Invalid information set in binary game file");
+    }
+    node->infoset = player->m_infosets[iset];
+    node->infoset->AddMember(node);
+    for (int act = 1; act <= node->infoset->m_actions.Length(); act++) {
+      node->children.Append(new GameTreeNodeRep(efg, node));
+    }
+    for (int act = node->children.Length(); act >= 1; act--) {
+      pending.push_back(node->children[act]);
+    }
+  }
+  if (!pending.empty()) {
+    throw InvalidFileException("Too few nodes in binary game file");
+  }
+
+  for (int pl = 0; pl <= nplayers; pl++) {
+    GamePlayerRep *player = (pl > 0) ? efg->m_players[pl] : efg->m_chance;
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      if (player->m_infosets[iset]->m_members.Length() == 0) {
+	throw InvalidFileException(
+	  "Information set without members in binary game file");
+      }
+    }
+  }
+
+  // Members were added to their information sets in preorder, and the
+  // information sets are in the order written, so only the nodes need
+  // numbering
+  int index = 1;
+  efg->NumberNodes(efg->m_root, index);
+  return game;
 }
 
 Game NewTree(void)  { return new GameTreeRep(); }
@@ -738,6 +951,8 @@ void GameTreeRep::ClearComputedValues(void) const
     }
   }
 
+  delete m_flatTree;
+  m_flatTree = 0;
   m_computedValues = false;
 }
 
@@ -916,6 +1131,62 @@ void GameTreeRep::WriteNfgFile(std::ostream &p_file) const
   p_file << '\n';
 }
 
+void GameTreeRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryGameWriter writer(p_file, BINARY_GAME_TREE);
+  writer.WriteString(GetTitle());
+  writer.WriteString(GetComment());
+
+  writer.WriteInt(m_players.Length());
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl > 0) ? m_players[pl] : m_chance;
+    if (pl > 0) {
+      writer.WriteString(player->m_label);
+    }
+    writer.WriteInt(player->m_infosets.Length());
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      writer.WriteString(infoset->m_label);
+      writer.WriteInt(infoset->m_actions.Length());
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	writer.WriteString(infoset->m_actions[act]->m_label);
+	if (pl == 0) {
+	  writer.WriteString(infoset->m_probs[act]);
+	}
+      }
+    }
+  }
+
+  WriteBinaryOutcomes(writer);
+
+  std::vector<GameTreeNodeRep *> nodes, pending(1, m_root);
+  while (!pending.empty()) {
+    GameTreeNodeRep *node = pending.back();
+    pending.pop_back();
+    nodes.push_back(node);
+    for (int i = node->children.Length(); i >= 1; i--) {
+      pending.push_back(node->children[i]);
+    }
+  }
+
+  writer.WriteInt(nodes.size());
+  std::vector<int> data(3 * nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    GameTreeNodeRep *node = nodes[i];
+    writer.WriteString(node->m_label);
+    if (node->infoset) {
+      data[3*i] = node->infoset->m_player->m_number;
+      data[3*i+1] = node->infoset->m_number;
+    }
+    else {
+      data[3*i] = -1;
+      data[3*i+1] = 0;
+    }
+    data[3*i+2] = (node->outcome) ? node->outcome->m_number : 0;
+  }
+  writer.WriteInts(&data[0], data.size());
+}
+
 //------------------------------------------------------------------------
 //                 GameTreeRep: Dimensions of the game
 //------------------------------------------------------------------------
@@ -1059,6 +1330,78 @@ int GameTreeRep::NumNodes(void) const
   return CountNodes(m_root);
 }
 
+const GameFlatTree &GameTreeRep::GetFlatTree(void) const
+{
+  if (m_flatTree) {
+    return *m_flatTree;
+  }
+
+  GameFlatTree *tree = new GameFlatTree;
+
+  // Index the information sets and moves player by player, chance last
+  Array<int> offsets(0, m_players.Length());
+  for (int i = 1; i <= m_players.Length() + 1; i++) {
+    GamePlayerRep *player = (i <= m_players.Length()) ? m_players[i] : m_chance;
+    offsets[player->m_number] = tree->m_infosetList.Length();
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      tree->m_infosetList.Append(infoset);
+      tree->m_players.Append(player->m_number);
+      tree->m_firstMoves.Append(tree->m_actions.Length() + 1);
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	tree->m_actions.Append(infoset->m_actions[act]);
+      }
+    }
+    if (i == m_players.Length()) {
+      tree->m_numPersonalInfosets = tree->m_infosetList.Length();
+    }
+  }
+
+  int numNodes = NumNodes();
+  tree->m_parents = Array<int>(numNodes);
+  tree->m_moves = Array<int>(numNodes);
+  tree->m_lastNodes = Array<int>(numNodes);
+  tree->m_infosets = Array<int>(numNodes);
+  tree->m_outcomes = Array<GameOutcomeRep *>(numNodes);
+  tree->m_postorder = Array<int>(numNodes);
+
+  // Walk the tree with an explicit stack of nodes and the number of
+  // their children visited so far
+  std::vector<std::pair<GameTreeNodeRep *, int> > stack;
+  stack.push_back(std::make_pair(m_root, 0));
+  tree->m_parents[m_root->number] = 0;
+  tree->m_moves[m_root->number] = 0;
+  int lastVisited = m_root->number, numFinished = 0;
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back().first;
+    int act = stack.back().second;
+    int infoset = 0;
+    if (node->infoset) {
+      infoset = offsets[node->infoset->m_player->m_number] + 
+	node->infoset->m_number;
+    }
+    if (act == 0) {
+      tree->m_infosets[node->number] = infoset;
+      tree->m_outcomes[node->number] = node->outcome;
+    }
+    if (act < node->children.Length()) {
+      GameTreeNodeRep *child = node->children[++stack.back().second];
+      tree->m_parents[child->number] = node->number;
+      tree->m_moves[child->number] = tree->m_firstMoves[infoset] + act;
+      lastVisited = child->number;
+      stack.push_back(std::make_pair(child, 0));
+    }
+    else {
+      tree->m_lastNodes[node->number] = lastVisited;
+      tree->m_postorder[++numFinished] = node->number;
+      stack.pop_back();
+    }
+  }
+
+  m_flatTree = tree;
+  return *m_flatTree;
+}
+
 //------------------------------------------------------------------------
 //                     GameTreeRep: Factory functions
 //------------------------------------------------------------------------
@@ -195,6 +195,59 @@ public:
   virtual GameInfoset InsertMove(GameInfoset p_infoset);
 };
 
+///
+/// A flattened copy of the structure of a game tree, for computations
+/// which sweep over all its nodes without recursion.  Nodes are indexed
+/// by their numbers, which run in preorder, so the descendants of a node
+/// are the nodes numbered after it up to the last node in its subtree.
+/// Information sets and moves (actions at information sets) are indexed
+/// consecutively: those of the personal players come first, in the order
+/// of the entries of a behavior profile, followed by those of chance.
+///
+class GameFlatTree {
+  friend class GameTreeRep;
+private:
+  Array<int> m_parents, m_moves, m_lastNodes, m_infosets, m_postorder;
+  Array<GameOutcomeRep *> m_outcomes;
+  Array<GameTreeInfosetRep *> m_infosetList;
+  Array<int> m_players, m_firstMoves;
+  Array<GameTreeActionRep *> m_actions;
+  int m_numPersonalInfosets;
+
+  GameFlatTree(void) : m_numPersonalInfosets(0) { }
+
+public:
+  /// @name Nodes
+  //@{
+  int NumNodes(void) const { return m_parents.Length(); }
+  /// Returns the parent of the node, or zero for the root
+  int GetParent(int p_node) const { return m_parents[p_node]; }
+  /// Returns the move leading to the node, or zero for the root
+  int GetMove(int p_node) const { return m_moves[p_node]; }
+  /// Returns the last node in the subtree rooted at the node
+  int GetLastNode(int p_node) const { return m_lastNodes[p_node]; }
+  /// Returns the information set at the node, or zero for terminal nodes
+  int GetInfoset(int p_node) const { return m_infosets[p_node]; }
+  /// Returns the outcome at the node, or null if there is none
+  GameOutcomeRep *GetOutcome(int p_node) const { return m_outcomes[p_node]; }
+  /// Returns the i'th node in postorder
+  int GetPostorder(int i) const { return m_postorder[i]; }
+  //@}
+
+  /// @name Information sets and moves
+  //@{
+  int NumInfosets(void) const { return m_infosetList.Length(); }
+  int NumPersonalInfosets(void) const { return m_numPersonalInfosets; }
+  GameTreeInfosetRep *GetInfosetRep(int p_infoset) const
+    { return m_infosetList[p_infoset]; }
+  /// Returns the number of the player at the information set (zero for chance)
+  int GetPlayer(int p_infoset) const { return m_players[p_infoset]; }
+  /// Returns the first move at the information set; the others follow it
+  int GetFirstMove(int p_infoset) const { return m_firstMoves[p_infoset]; }
+  int NumMoves(void) const { return m_actions.Length(); }
+  GameTreeActionRep *GetAction(int p_move) const { return m_actions[p_move]; }
+  //@}
+};
 
 class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
@@ -204,10 +257,14 @@ protected:
   mutable bool m_computedValues;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  /// The flattened tree, built when first asked for
+  mutable GameFlatTree *m_flatTree;
 
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  /// Build a new game from the subtree rooted at the node
+  Game CopyGame(const GameTreeNodeRep *) const;
   //@}
 
   /// @name Managing the representation
@@ -225,6 +282,8 @@ public:
   GameTreeRep(void);
   virtual ~GameTreeRep();
   virtual Game Copy(void) const;
+  /// Build a game from the rest of a binary savefile
+  static Game ReadBinaryFile(BinaryGameReader &);
   //@}
 
   /// @name General data access
@@ -248,6 +307,8 @@ public:
   virtual GameNode GetRoot(void) const { return m_root; } 
   /// Returns the number of nodes in the game
   int NumNodes(void) const;
+  /// Returns the flattened tree, which lasts until the game is changed
+  const GameFlatTree &GetFlatTree(void) const;
   //@}
 
   virtual void DeleteOutcome(const GameOutcome &);
@@ -257,6 +318,7 @@ public:
   virtual void WriteEfgFile(std::ostream &) const;
   virtual void WriteEfgFile(std::ostream &, const GameNode &p_node) const;
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   /// @name Dimensions of the game
@@ -0,0 +1,552 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/gmpinteger.cc
+// Implementation of arbitrary-precision integers using the GNU MP library
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <cctype>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+#include "libgambit.h"
+
+// Without --with-gmp, Integer is implemented in integer.cc
+#ifdef USE_GMP
+
+namespace Gambit {
+
+namespace {
+
+//
+// The magnitude of a long, which is representable as an unsigned long
+// even for the most negative long
+//
+unsigned long Magnitude(long x)
+{
+  return (x < 0) ? -((unsigned long) x) : (unsigned long) x;
+}
+
+int Sign(int x)
+{
+  return (x > 0) ? 1 : ((x < 0) ? -1 : 0);
+}
+
+void CheckDivisor(const mpz_t y)
+{
+  if (mpz_sgn(y) == 0) {
+    throw ZeroDivideException();
+  }
+}
+
+void CheckDivisor(long y)
+{
+  if (y == 0) {
+    throw ZeroDivideException();
+  }
+}
+
+void Shift(mpz_t dest, const mpz_t x, long y)
+{
+  if (y >= 0) {
+    mpz_mul_2exp(dest, x, y);
+  }
+  else {
+    mpz_tdiv_q_2exp(dest, x, Magnitude(y));
+  }
+}
+
+void Power(mpz_t dest, const mpz_t x, long y)
+{
+  if (y == 0 || mpz_cmpabs_ui(x, 1) == 0) {
+    int sgn = (mpz_sgn(x) >= 0 || !(y & 1)) ? 1 : -1;
+    mpz_set_si(dest, sgn);
+  }
+  else if (mpz_sgn(x) == 0 || y < 0) {
+    mpz_set_ui(dest, 0);
+  }
+  else {
+    mpz_pow_ui(dest, x, y);
+  }
+}
+
+} // end anonymous namespace
+
+//========================================================================
+//                      Lifecycle and assignment
+//========================================================================
+
+Integer::Integer(void) { mpz_init(rep); }
+
+Integer::Integer(int y) { mpz_init_set_si(rep, y); }
+
+Integer::Integer(long y) { mpz_init_set_si(rep, y); }
+
+Integer::Integer(unsigned long y) { mpz_init_set_ui(rep, y); }
+
+Integer::Integer(const Integer &y) { mpz_init_set(rep, y.rep); }
+
+Integer::~Integer() { mpz_clear(rep); }
+
+Integer &Integer::operator=(const Integer &y)
+{
+  mpz_set(rep, y.rep);
+  return *this;
+}
+
+Integer &Integer::operator=(long y)
+{
+  mpz_set_si(rep, y);
+  return *this;
+}
+
+int Integer::initialized() const { return 1; }
+
+void Integer::error(const char *) const { }
+
+int Integer::OK() const { return 1; }
+
+//========================================================================
+//                     Coercion and conversion
+//========================================================================
+
+int Integer::fits_in_long() const { return mpz_fits_slong_p(rep); }
+
+// Values out of range are clamped to the most negative or positive long
+long Integer::as_long() const
+{
+  if (mpz_fits_slong_p(rep)) {
+    return mpz_get_si(rep);
+  }
+  return (mpz_sgn(rep) > 0) ? LONG_MAX : LONG_MIN;
+}
+
+//
+// The conversions to double accumulate the bits of the magnitude from
+// the most significant down, rounding as they go, so they give the same
+// results as the GNU C++ Library implementation.
+//
+double Integer::as_double() const
+{
+  Integer x(*this);
+  x.abs();
+  double d = 0.0;
+  double bound = DBL_MAX / 2.0;
+  for (long b = mpz_sizeinbase(x.rep, 2) - 1; b >= 0; b--) {
+    if (d >= bound) {
+      return (sign(*this) < 0) ? -HUGE_VAL : HUGE_VAL;
+    }
+    d *= 2.0;
+    if (mpz_tstbit(x.rep, b)) d += 1.0;
+  }
+  return (sign(*this) < 0) ? -d : d;
+}
+
+int Integer::fits_in_double() const
+{
+  Integer x(*this);
+  x.abs();
+  double d = 0.0;
+  double bound = DBL_MAX / 2.0;
+  for (long b = mpz_sizeinbase(x.rep, 2) - 1; b >= 0; b--) {
+    int bit = mpz_tstbit(x.rep, b);
+    if (d > bound || (d == bound && (b > 0 || bit))) {
+      return 0;
+    }
+    d *= 2.0;
+    if (bit) d += 1.0;
+  }
+  return 1;
+}
+
+double ratio(const Integer &num, const Integer &den)
+{
+  Integer q, r;
+  divide(num, den, q, r);
+  double d1 = q.as_double();
+
+  if (d1 >= DBL_MAX || d1 <= -DBL_MAX || sign(r) == 0) {
+    return d1;
+  }
+
+  // use as much precision as available for the fractional part
+  Integer absDen(abs(den)), absRem(abs(r));
+  double d2 = 0.0, d3 = 0.0;
+  for (long b = mpz_sizeinbase(absDen.rep, 2) - 1; b >= 0; b--) {
+    if (d2 + 1.0 == d2) break;    // out of precision
+    d2 *= 2.0;
+    if (mpz_tstbit(absDen.rep, b)) d2 += 1.0;
+    d3 *= 2.0;
+    if (mpz_tstbit(absRem.rep, b)) d3 += 1.0;
+  }
+
+  // the fractional part is r/den, whose sign depends on both
+  if (sign(r) != sign(den)) d3 = -d3;
+  return d1 + d3 / d2;
+}
+
+std::string Itoa(const Integer &x, int base, int width)
+{
+  char *digits = mpz_get_str(0, base, x.rep);
+  std::string s(digits);
+  void (*freefunc)(void *, size_t);
+  mp_get_memory_functions(0, 0, &freefunc);
+  freefunc(digits, s.length() + 1);
+
+  if ((int) s.length() < width) {
+    s.insert(0, width - s.length(), ' ');
+  }
+  return s;
+}
+
+Integer atoI(const char *s, int base)
+{
+  Integer r;
+  while (isspace(*s)) ++s;
+  bool negative = (*s == '-');
+  if (*s == '-' || *s == '+') ++s;
+  for (;; ++s) {
+    long digit;
+    if (*s >= '0' && *s <= '9') digit = *s - '0';
+    else if (*s >= 'a' && *s <= 'z') digit = *s - 'a' + 10;
+    else if (*s >= 'A' && *s <= 'Z') digit = *s - 'A' + 10;
+    else break;
+    if (digit >= base) break;
+    mpz_mul_ui(r.rep, r.rep, base);
+    mpz_add_ui(r.rep, r.rep, digit);
+  }
+  if (negative) r.negate();
+  return r;
+}
+
+std::ostream &operator<<(std::ostream &s, const Integer &y)
+{
+  return s << Itoa(y, 10, 0);
+}
+
+std::istream &operator>>(std::istream &s, Integer &y)
+{
+  char sgn = 0;
+  char ch;
+  y = 0L;
+
+  do  {
+    s.get(ch);
+  }  while (isspace(ch));
+
+  s.unget();
+
+  while (s.get(ch)) {
+    if (ch == '-') {
+      if (sgn == 0)
+	sgn = '-';
+      else
+	break;
+    }
+    else if (ch >= '0' && ch <= '9') {
+      mpz_mul_ui(y.rep, y.rep, 10);
+      mpz_add_ui(y.rep, y.rep, ch - '0');
+    }
+    else
+      break;
+  }
+  s.unget();
+
+  if (sgn == '-')
+    y.negate();
+
+  return s;
+}
+
+//========================================================================
+//                     Procedural versions of operators
+//========================================================================
+
+int compare(const Integer &x, const Integer &y)
+{ return Sign(mpz_cmp(x.rep, y.rep)); }
+
+int ucompare(const Integer &x, const Integer &y)
+{ return Sign(mpz_cmpabs(x.rep, y.rep)); }
+
+int compare(const Integer &x, long y)
+{ return Sign(mpz_cmp_si(x.rep, y)); }
+
+int ucompare(const Integer &x, long y)
+{ return Sign(mpz_cmpabs_ui(x.rep, Magnitude(y))); }
+
+int compare(long x, const Integer &y)
+{ return -compare(y, x); }
+
+int ucompare(long x, const Integer &y)
+{ return -ucompare(y, x); }
+
+void add(const Integer &x, const Integer &y, Integer &dest)
+{ mpz_add(dest.rep, x.rep, y.rep); }
+
+void sub(const Integer &x, const Integer &y, Integer &dest)
+{ mpz_sub(dest.rep, x.rep, y.rep); }
+
+void mul(const Integer &x, const Integer &y, Integer &dest)
+{ mpz_mul(dest.rep, x.rep, y.rep); }
+
+void div(const Integer &x, const Integer &y, Integer &dest)
+{
+  CheckDivisor(y.rep);
+  mpz_tdiv_q(dest.rep, x.rep, y.rep);
+}
+
+void mod(const Integer &x, const Integer &y, Integer &dest)
+{
+  CheckDivisor(y.rep);
+  mpz_tdiv_r(dest.rep, x.rep, y.rep);
+}
+
+void divide(const Integer &x, const Integer &y, Integer &q, Integer &r)
+{
+  CheckDivisor(y.rep);
+  mpz_tdiv_qr(q.rep, r.rep, x.rep, y.rep);
+}
+
+void lshift(const Integer &x, const Integer &y, Integer &dest)
+{ Shift(dest.rep, x.rep, y.as_long()); }
+
+void rshift(const Integer &x, const Integer &y, Integer &dest)
+{ Shift(dest.rep, x.rep, -y.as_long()); }
+
+void pow(const Integer &x, const Integer &y, Integer &dest)
+{ Power(dest.rep, x.rep, y.as_long()); }
+
+void add(const Integer &x, long y, Integer &dest)
+{
+  if (y >= 0) mpz_add_ui(dest.rep, x.rep, y);
+  else mpz_sub_ui(dest.rep, x.rep, Magnitude(y));
+}
+
+void sub(const Integer &x, long y, Integer &dest)
+{
+  if (y >= 0) mpz_sub_ui(dest.rep, x.rep, y);
+  else mpz_add_ui(dest.rep, x.rep, Magnitude(y));
+}
+
+void mul(const Integer &x, long y, Integer &dest)
+{ mpz_mul_si(dest.rep, x.rep, y); }
+
+void div(const Integer &x, long y, Integer &dest)
+{
+  CheckDivisor(y);
+  mpz_tdiv_q_ui(dest.rep, x.rep, Magnitude(y));
+  if (y < 0) mpz_neg(dest.rep, dest.rep);
+}
+
+void mod(const Integer &x, long y, Integer &dest)
+{
+  CheckDivisor(y);
+  mpz_tdiv_r_ui(dest.rep, x.rep, Magnitude(y));
+}
+
+void divide(const Integer &x, long y, Integer &q, long &r)
+{
+  CheckDivisor(y);
+  Integer rem;
+  mpz_tdiv_qr_ui(q.rep, rem.rep, x.rep, Magnitude(y));
+  if (y < 0) mpz_neg(q.rep, q.rep);
+  r = mpz_get_si(rem.rep);
+}
+
+void lshift(const Integer &x, long y, Integer &dest)
+{ Shift(dest.rep, x.rep, y); }
+
+void rshift(const Integer &x, long y, Integer &dest)
+{ Shift(dest.rep, x.rep, -y); }
+
+void pow(const Integer &x, long y, Integer &dest)
+{ Power(dest.rep, x.rep, y); }
+
+void abs(const Integer &x, Integer &dest)
+{ mpz_abs(dest.rep, x.rep); }
+
+void negate(const Integer &x, Integer &dest)
+{ mpz_neg(dest.rep, x.rep); }
+
+// Complements the bits of the magnitude below its highest set bit
+void complement(const Integer &x, Integer &dest)
+{
+  int sgn = mpz_sgn(x.rep);
+  mpz_abs(dest.rep, x.rep);
+  for (long b = (long) mpz_sizeinbase(dest.rep, 2) - 2; b >= 0; b--) {
+    mpz_combit(dest.rep, b);
+  }
+  if (sgn < 0) mpz_neg(dest.rep, dest.rep);
+}
+
+void add(long x, const Integer &y, Integer &dest)
+{ add(y, x, dest); }
+
+void sub(long x, const Integer &y, Integer &dest)
+{
+  sub(y, x, dest);
+  mpz_neg(dest.rep, dest.rep);
+}
+
+void mul(long x, const Integer &y, Integer &dest)
+{ mpz_mul_si(dest.rep, y.rep, x); }
+
+//========================================================================
+//                        Builtin functions
+//========================================================================
+
+long lg(const Integer &x)
+{ return (mpz_sgn(x.rep) == 0) ? 0 : (long) mpz_sizeinbase(x.rep, 2) - 1; }
+
+Integer gcd(const Integer &x, const Integer &y)
+{
+  Integer r;
+  mpz_gcd(r.rep, x.rep, y.rep);
+  return r;
+}
+
+int even(const Integer &y) { return mpz_even_p(y.rep); }
+
+int odd(const Integer &y) { return mpz_odd_p(y.rep); }
+
+int sign(const Integer &x) { return mpz_sgn(x.rep); }
+
+// The bit operations act on the magnitude, keeping the sign
+void setbit(Integer &x, long b)
+{
+  if (b < 0) return;
+  int sgn = mpz_sgn(x.rep);
+  mpz_abs(x.rep, x.rep);
+  mpz_setbit(x.rep, b);
+  if (sgn < 0) mpz_neg(x.rep, x.rep);
+}
+
+void clearbit(Integer &x, long b)
+{
+  if (b < 0) return;
+  int sgn = mpz_sgn(x.rep);
+  mpz_abs(x.rep, x.rep);
+  mpz_clrbit(x.rep, b);
+  if (sgn < 0) mpz_neg(x.rep, x.rep);
+}
+
+int testbit(const Integer &x, long b)
+{
+  if (b < 0) return 0;
+  Integer a(abs(x));
+  return mpz_tstbit(a.rep, b);
+}
+
+Integer sqrt(const Integer &x)
+{
+  Integer r(x);
+  int s = sign(x);
+  if (s < 0) x.error("Attempted square root of negative Integer");
+  if (s > 0) {
+    r >>= (lg(x) / 2); // get close
+    Integer q;
+    div(x, r, q);
+    while (q < r) {
+      r += q;
+      r >>= 1;
+      div(x, r, q);
+    }
+  }
+  return r;
+}
+
+Integer lcm(const Integer &x, const Integer &y)
+{
+  Integer g;
+  if (sign(x) == 0 || sign(y) == 0)
+    g = 1L;
+  else
+    g = gcd(x, y);
+  Integer r;
+  div(x, g, r);
+  mul(r, y, r);
+  return r;
+}
+
+//========================================================================
+//                     Operators, in terms of the above
+//========================================================================
+
+void Integer::operator ++ () { add(*this, 1L, *this); }
+void Integer::operator -- () { add(*this, -1L, *this); }
+void Integer::negate() { mpz_neg(rep, rep); }
+void Integer::abs() { mpz_abs(rep, rep); }
+
+bool Integer::operator==(const Integer &y) const { return compare(*this, y) == 0; }
+bool Integer::operator==(long y) const { return compare(*this, y) == 0; }
+bool Integer::operator!=(const Integer &y) const { return compare(*this, y) != 0; }
+bool Integer::operator!=(long y) const { return compare(*this, y) != 0; }
+bool Integer::operator< (const Integer &y) const { return compare(*this, y) < 0; }
+bool Integer::operator< (long y) const { return compare(*this, y) < 0; }
+bool Integer::operator<=(const Integer &y) const { return compare(*this, y) <= 0; }
+bool Integer::operator<=(long y) const { return compare(*this, y) <= 0; }
+bool Integer::operator> (const Integer &y) const { return compare(*this, y) > 0; }
+bool Integer::operator> (long y) const { return compare(*this, y) > 0; }
+bool Integer::operator>=(const Integer &y) const { return compare(*this, y) >= 0; }
+bool Integer::operator>=(long y) const { return compare(*this, y) >= 0; }
+
+Integer &Integer::operator+=(const Integer &y) { add(*this, y, *this); return *this; }
+Integer &Integer::operator-=(const Integer &y) { sub(*this, y, *this); return *this; }
+Integer &Integer::operator*=(const Integer &y) { mul(*this, y, *this); return *this; }
+Integer &Integer::operator/=(const Integer &y) { div(*this, y, *this); return *this; }
+Integer &Integer::operator%=(const Integer &y) { mod(*this, y, *this); return *this; }
+Integer &Integer::operator<<=(const Integer &y) { lshift(*this, y, *this); return *this; }
+Integer &Integer::operator>>=(const Integer &y) { rshift(*this, y, *this); return *this; }
+
+Integer &Integer::operator+=(long y) { add(*this, y, *this); return *this; }
+Integer &Integer::operator-=(long y) { sub(*this, y, *this); return *this; }
+Integer &Integer::operator*=(long y) { mul(*this, y, *this); return *this; }
+Integer &Integer::operator/=(long y) { div(*this, y, *this); return *this; }
+Integer &Integer::operator%=(long y) { mod(*this, y, *this); return *this; }
+Integer &Integer::operator<<=(long y) { lshift(*this, y, *this); return *this; }
+Integer &Integer::operator>>=(long y) { rshift(*this, y, *this); return *this; }
+
+Integer Integer::operator-(void) const
+{ Integer r; Gambit::negate(*this, r); return r; }
+
+Integer Integer::operator+(const Integer &y) const { Integer r; add(*this, y, r); return r; }
+Integer Integer::operator+(long y) const { Integer r; add(*this, y, r); return r; }
+Integer Integer::operator-(const Integer &y) const { Integer r; sub(*this, y, r); return r; }
+Integer Integer::operator-(long y) const { Integer r; sub(*this, y, r); return r; }
+Integer Integer::operator*(const Integer &y) const { Integer r; mul(*this, y, r); return r; }
+Integer Integer::operator*(long y) const { Integer r; mul(*this, y, r); return r; }
+Integer Integer::operator/(const Integer &y) const { Integer r; div(*this, y, r); return r; }
+Integer Integer::operator/(long y) const { Integer r; div(*this, y, r); return r; }
+Integer Integer::operator%(const Integer &y) const { Integer r; mod(*this, y, r); return r; }
+Integer Integer::operator%(long y) const { Integer r; mod(*this, y, r); return r; }
+Integer Integer::operator<<(const Integer &y) const { Integer r; lshift(*this, y, r); return r; }
+Integer Integer::operator<<(long y) const { Integer r; lshift(*this, y, r); return r; }
+Integer Integer::operator>>(const Integer &y) const { Integer r; rshift(*this, y, r); return r; }
+Integer Integer::operator>>(long y) const { Integer r; rshift(*this, y, r); return r; }
+
+Integer abs(const Integer &x) { Integer r; abs(x, r); return r; }
+Integer sqr(const Integer &x) { Integer r; mul(x, x, r); return r; }
+Integer pow(const Integer &x, const Integer &y) { Integer r; pow(x, y, r); return r; }
+Integer pow(const Integer &x, long y) { Integer r; pow(x, y, r); return r; }
+Integer Ipow(long x, long y) { Integer r(x); pow(r, y, r); return r; }
+
+} // end namespace Gambit
+
+#endif  // USE_GMP
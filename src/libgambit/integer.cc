@@ -44,6 +44,9 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <cstring>
 #include "libgambit/libgambit.h"
 
+// When configured --with-gmp, Integer is implemented in gmpinteger.cc
+#ifndef USE_GMP
+
 namespace Gambit {
 
 long lg(unsigned long x)
@@ -198,7 +201,7 @@ IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int n
               int newlen)
 {
   IntegerRep* rep;
-  if (old == 0 || newlen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
     rep = Inew(newlen);
   else
     rep = old;
@@ -218,7 +221,7 @@ IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int n
 IntegerRep* Icalloc(IntegerRep* old, int newlen)
 {
   IntegerRep* rep;
-  if (old == 0 || newlen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
     rep = Inew(newlen);
@@ -248,7 +251,7 @@ IntegerRep* Iresize(IntegerRep* old, int newlen)
   else 
   {
     oldlen = old->len;
-    if (newlen > old->sz)
+    if (STATIC_IntegerRep(old) || newlen > old->sz)
     {
       rep = Inew(newlen);
       scpy(old->s, rep->s, oldlen);
@@ -274,7 +277,7 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
   IntegerRep* rep;
   if (src == 0)
   {
-    if (old == 0)
+    if (old == 0 || STATIC_IntegerRep(old))
       rep = Inew(0);
     else
     {
@@ -287,7 +290,7 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
   else 
   {
     int newlen = src->len;
-    if (old == 0 || newlen > old->sz)
+    if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
     {
       if (old != 0 && !STATIC_IntegerRep(old)) delete old;
       rep = Inew(newlen);
@@ -322,11 +325,11 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x >>= I_SHIFT;     // not down(), which keeps only the next limb
   }
 
   IntegerRep* rep;
-  if (old == 0 || srclen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || srclen > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
     rep = Inew(srclen);
@@ -2055,6 +2058,8 @@ IntegerRep* abs(const IntegerRep* src, IntegerRep* dest)
   nonnil(src);
   if (src != dest)
     dest = Icopy(dest, src);
+  else if (STATIC_IntegerRep(dest))   // shared constant, as for one
+    dest = Icopy(0, src);
   dest->sgn = I_POSITIVE;
   return dest;
 }
@@ -2064,6 +2069,8 @@ IntegerRep* negate(const IntegerRep* src, IntegerRep* dest)
   nonnil(src);
   if (src != dest)
     dest = Icopy(dest, src);
+  else if (STATIC_IntegerRep(dest))   // shared constant, as for one
+    dest = Icopy(0, src);
   if (dest->len != 0) 
     dest->sgn = !dest->sgn;
   return dest;
@@ -2901,3 +2908,5 @@ Integer &Integer::operator%=(long y)
 }
 
 }
+
+#endif  // !USE_GMP
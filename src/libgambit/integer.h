@@ -29,9 +29,15 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #define LIBGAMBIT_INTEGER_H
 
 #include <string>
+#include <config.h>
+
+#ifdef USE_GMP
+#include <gmp.h>
+#endif  // USE_GMP
 
 namespace Gambit {
 
+#ifndef USE_GMP
 struct IntegerRep                    // internal Integer representations
 {
   unsigned short  len;          // current length
@@ -81,10 +87,22 @@ extern double   Itodouble(const IntegerRep*);
 extern int      Iislong(const IntegerRep*);
 extern int      Iisdouble(const IntegerRep*);
 extern long     lg(const IntegerRep*);
+#endif  // !USE_GMP
 
+//
+// Integers are represented either by the implementation from the GNU C++
+// Library below, or, when configured --with-gmp, by the GNU MP library.
+// The two behave the same: division truncates towards zero, remainders
+// take the sign of the dividend, and shifts and bit operations act on
+// the absolute value.
+//
 class Integer {
 protected:
+#ifdef USE_GMP
+  mpz_t rep;
+#else
   IntegerRep *rep;
+#endif  // USE_GMP
 
 public:
   /// @name Lifecycle
@@ -93,7 +111,9 @@ public:
   Integer(int);
   Integer(long);
   Integer(unsigned long);
+#ifndef USE_GMP
   Integer(IntegerRep *);
+#endif  // !USE_GMP
   Integer(const Integer &);
   ~Integer();
 
@@ -218,11 +238,19 @@ public:
 
   // coercion & conversion
 
+#ifdef USE_GMP
+  int             fits_in_long() const;
+  int             fits_in_double() const;
+
+  long		  as_long() const;
+  double	  as_double() const;
+#else
   int             fits_in_long() const { return Iislong(rep); }
   int             fits_in_double() const { return Iisdouble(rep); }
 
   long		  as_long() const { return Itolong(rep); }
   double	  as_double() const { return Itodouble(rep); }
+#endif  // USE_GMP
 
   friend std::string Itoa(const Integer &x, int base /*= 10*/, int width /*= 0*/);
   friend Integer atoI(const char *s, int base/*= 10*/);
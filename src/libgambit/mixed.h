@@ -24,11 +24,14 @@
 #define LIBGAMBIT_MIXED_H
 
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
 namespace Gambit {
 
+class GameTableRep;
+
 template <class T> class MixedStrategyProfileRep {
 public:
   Vector<T> m_probs;
@@ -49,6 +52,10 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  /// Computes all payoffs and strategy values; by default, one at a time
+  virtual void GetPayoffs(Vector<T> &p_payoffs, Vector<T> &p_values) const;
+  /// Computes all second derivatives; by default, one pair at a time
+  virtual void GetPayoffDerivs(Matrix<T> &p_derivs) const;
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -71,26 +78,40 @@ template <class T> class TableMixedStrategyProfileRep
 private:
   /// @name Private recursive payoff functions
   //@{
-  /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
+  /// Recursive computation of payoff, given the player's payoff table
+  T GetPayoff(const T *p_payoffs, long index, int i) const;
   /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
-		      const T &prob, T &value) const;
+  void GetPayoffDeriv(const T *p_payoffs, int const_pl, int cur_pl,
+		      long index, const T &prob, T &value) const;
   /// Recursive computation of payoff second derivative
-  void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
+  void GetPayoffDeriv(const T *p_payoffs, int const_pl1, int const_pl2, 
 		      int cur_pl, long index, const T &prob, T &value) const;
   //@}
 
+  /// Probabilities indexed by all strategies in the game, and the number
+  /// of strategies of each player
+  void GetTableProbs(Array<Array<T> > &p_probs, Array<int> &p_dims) const;
+
+  /// The game on which the profile is defined, bound on construction
+  GameTableRep *m_table;
+  /// @name Strategies in the support, bound on construction
+  //@{
+  /// The offset into the payoff table of each strategy, by player
+  Array<Array<long> > m_offsets;
+  /// The index into the profile of each strategy, by player
+  Array<Array<int> > m_indices;
+  //@}
+
 public:
-  TableMixedStrategyProfileRep(const StrategySupport &p_support)
-    : MixedStrategyProfileRep<T>(p_support)
-  { }
+  TableMixedStrategyProfileRep(const StrategySupport &p_support);
   virtual ~TableMixedStrategyProfileRep() { }
 
   virtual MixedStrategyProfileRep<T> *Copy(void) const;
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetPayoffs(Vector<T> &p_payoffs, Vector<T> &p_values) const;
+  virtual void GetPayoffDerivs(Matrix<T> &p_derivs) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -234,6 +255,31 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoffs to all players and all strategies at once
+  ///
+  /// Computes the payoff to each player, stored in p_payoffs (indexed
+  /// by player number), and the payoff to playing each strategy in the
+  /// support against the profile, stored in p_values (indexed as the
+  /// profile itself).  The vectors must already be of the correct length.
+  /// For strategic games, this is much faster than calling GetPayoff()
+  /// for each player and strategy in turn.
+  void GetPayoffs(Vector<T> &p_payoffs, Vector<T> &p_values) const
+  { m_rep->GetPayoffs(p_payoffs, p_values); }
+
+  /// \brief Computes the second derivatives of payoffs for all pairs
+  ///
+  /// Computes, for every pair of strategies in the support, the second
+  /// derivative of the payoff to the player owning the first strategy,
+  /// with respect to the probabilities of the two strategies.  Entry
+  /// (i, j) of p_derivs, which must be a square matrix indexed as the
+  /// profile, is set to GetPayoffDeriv(pl, s_i, s_j), where s_i and s_j
+  /// are the i'th and j'th strategies in the profile and pl is the
+  /// player of s_i.  For strategic games, this is computed in one pass
+  /// over the payoff tables, which is much faster than calling 
+  /// GetPayoffDeriv() for each pair.
+  void GetPayoffDerivs(Matrix<T> &p_derivs) const
+  { m_rep->GetPayoffDerivs(p_derivs); }
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
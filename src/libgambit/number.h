@@ -55,6 +55,68 @@ public:
   operator const std::string &(void) const { return m_text; }
 };
 
+/// This class stores a numerical datum compactly, for use when there
+/// are very many of them.  It holds an integer, a fraction, or a decimal
+/// whose digits fit in an int, and keeps enough of how it was written
+/// to give back the same text as a Number would.
+class CompactNumber {
+private:
+  int m_numerator, m_denominator, m_decimals;
+
+public:
+  CompactNumber(void)
+    : m_numerator(0), m_denominator(1), m_decimals(0) { }
+  /// The fraction p_numerator/p_denominator, written as such, or as an 
+  /// integer if the denominator is one
+  CompactNumber(int p_numerator, int p_denominator)
+    : m_numerator(p_numerator), m_denominator(p_denominator), 
+      m_decimals(0) { }
+  /// The decimal p_mantissa/p_denominator, where the denominator is 
+  /// 10^p_decimals, written with p_decimals digits after the point
+  CompactNumber(int p_mantissa, int p_denominator, int p_decimals)
+    : m_numerator(p_mantissa), m_denominator(p_denominator),
+      m_decimals(p_decimals) { }
+
+  int GetNumerator(void) const { return m_numerator; }
+  int GetDenominator(void) const { return m_denominator; }
+  /// The number of digits written after the decimal point; zero if 
+  /// written as an integer or fraction
+  int GetDecimals(void) const { return m_decimals; }
+
+  operator double(void) const 
+  { 
+    // Fractions go through Rational, to round the same way as Number
+    if (m_denominator == 1) {
+      return (double) m_numerator;
+    }
+    return (double) Rational(m_numerator, m_denominator);
+  }
+  operator Rational(void) const 
+  { 
+    if (m_denominator == 1) {
+      return Rational(m_numerator);
+    }
+    return Rational(m_numerator, m_denominator); 
+  }
+
+  std::string GetText(void) const
+  {
+    std::ostringstream s;
+    if (m_decimals == 0) {
+      s << m_numerator;
+      if (m_denominator != 1)  s << '/' << m_denominator;
+    }
+    else {
+      unsigned int mantissa = (m_numerator < 0) ? -m_numerator : m_numerator;
+      if (m_numerator < 0)  s << '-';
+      s << mantissa / m_denominator << '.' 
+	<< std::setw(m_decimals) << std::setfill('0') 
+	<< mantissa % m_denominator;
+    }
+    return s.str();
+  }
+};
+
 }
 
 #endif // LIBGAMBIT_NUMBER_H
@@ -0,0 +1,173 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/parallel.cc
+// Running computations on several threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include "parallel.h"
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif  // HAVE_PTHREAD_H
+
+namespace Gambit {
+
+namespace {
+
+/// The part of a task run by one thread, and whether it failed
+struct TaskPart {
+  ParallelTask *m_task;
+  int m_part, m_numParts;
+  bool m_failed;
+};
+
+void RunPart(TaskPart &p_part)
+{
+  try {
+    p_part.m_task->Run(p_part.m_part, p_part.m_numParts);
+  }
+  catch (...) {
+    p_part.m_failed = true;
+  }
+}
+
+#ifdef HAVE_PTHREAD_H
+void *RunThread(void *p_part)
+{
+  RunPart(*static_cast<TaskPart *>(p_part));
+  return 0;
+}
+#endif  // HAVE_PTHREAD_H
+
+}  // end anonymous namespace
+
+bool HasThreads(void)
+{
+#ifdef HAVE_PTHREAD_H
+  return true;
+#else
+  return false;
+#endif  // HAVE_PTHREAD_H
+}
+
+void RunParallel(ParallelTask &p_task, int p_numParts)
+{
+  Array<TaskPart> parts(p_numParts);
+  for (int i = 1; i <= p_numParts; i++) {
+    parts[i].m_task = &p_task;
+    parts[i].m_part = i;
+    parts[i].m_numParts = p_numParts;
+    parts[i].m_failed = false;
+  }
+
+#ifdef HAVE_PTHREAD_H
+  // The first part runs on the calling thread.  If a thread cannot be
+  // created, its part is run on the calling thread as well.
+  Array<pthread_t> threads(p_numParts);
+  Array<bool> started(p_numParts);
+  for (int i = 2; i <= p_numParts; i++) {
+    started[i] = (pthread_create(&threads[i], 0, RunThread, &parts[i]) == 0);
+  }
+  RunPart(parts[1]);
+  for (int i = 2; i <= p_numParts; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], 0);
+    }
+    else {
+      RunPart(parts[i]);
+    }
+  }
+#else
+  for (int i = 1; i <= p_numParts; i++) {
+    RunPart(parts[i]);
+  }
+#endif  // HAVE_PTHREAD_H
+
+  for (int i = 1; i <= p_numParts; i++) {
+    if (parts[i].m_failed) {
+      throw ParallelException();
+    }
+  }
+}
+
+//========================================================================
+//                     class Mutex, class Condition
+//========================================================================
+
+#ifdef HAVE_PTHREAD_H
+
+struct Mutex::Rep {
+  pthread_mutex_t m_mutex;
+};
+
+Mutex::Mutex(void) : m_rep(new Rep)
+{
+  pthread_mutex_init(&m_rep->m_mutex, 0);
+}
+
+Mutex::~Mutex()
+{
+  pthread_mutex_destroy(&m_rep->m_mutex);
+  delete m_rep;
+}
+
+void Mutex::Lock(void) { pthread_mutex_lock(&m_rep->m_mutex); }
+
+void Mutex::Unlock(void) { pthread_mutex_unlock(&m_rep->m_mutex); }
+
+struct Condition::Rep {
+  pthread_cond_t m_condition;
+};
+
+Condition::Condition(void) : m_rep(new Rep)
+{
+  pthread_cond_init(&m_rep->m_condition, 0);
+}
+
+Condition::~Condition()
+{
+  pthread_cond_destroy(&m_rep->m_condition);
+  delete m_rep;
+}
+
+void Condition::Wait(Mutex &p_mutex)
+{
+  pthread_cond_wait(&m_rep->m_condition, &p_mutex.m_rep->m_mutex);
+}
+
+void Condition::Broadcast(void)
+{
+  pthread_cond_broadcast(&m_rep->m_condition);
+}
+
+#else
+
+Mutex::Mutex(void) : m_rep(0) { }
+Mutex::~Mutex() { }
+void Mutex::Lock(void) { }
+void Mutex::Unlock(void) { }
+
+Condition::Condition(void) : m_rep(0) { }
+Condition::~Condition() { }
+void Condition::Wait(Mutex &) { }
+void Condition::Broadcast(void) { }
+
+#endif  // HAVE_PTHREAD_H
+
+} // end namespace Gambit
@@ -0,0 +1,115 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/parallel.h
+// Running computations on several threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_PARALLEL_H
+#define LIBGAMBIT_PARALLEL_H
+
+#include "libgambit.h"
+
+namespace Gambit {
+
+/// Exception thrown when a parallel task fails on one of its threads
+class ParallelException : public Exception {
+public:
+  virtual ~ParallelException() throw() { }
+  const char *what(void) const throw()  
+  { return "A computation failed on one of its threads"; }
+};
+
+/// A computation split into parts which can run concurrently.
+/// Game objects are reference counted without locking, so the parts
+/// should not create or copy handles to game objects; they should 
+/// work on data which is set up before the task is run.
+class ParallelTask {
+public:
+  virtual ~ParallelTask() { }
+
+  /// Do part p_part (numbered from 1) out of p_numParts
+  virtual void Run(int p_part, int p_numParts) = 0;
+};
+
+/// Run each part of the task on its own thread, and wait for all of
+/// them to finish.  If the library is built without thread support,
+/// the parts are run one after another.  If any part throws an 
+/// exception, ParallelException is thrown once all parts are done.
+void RunParallel(ParallelTask &p_task, int p_numParts);
+
+/// Returns whether the library is built with thread support
+bool HasThreads(void);
+
+/// A lock on data shared between the parts of a task.  If the library
+/// is built without thread support, locking does nothing.
+class Mutex {
+  friend class Condition;
+private:
+  struct Rep;
+  Rep *m_rep;
+
+  Mutex(const Mutex &);
+  Mutex &operator=(const Mutex &);
+
+public:
+  Mutex(void);
+  ~Mutex();
+
+  void Lock(void);
+  void Unlock(void);
+};
+
+/// Holds a mutex locked for as long as the object exists
+class MutexLock {
+private:
+  Mutex &m_mutex;
+
+  MutexLock(const MutexLock &);
+  MutexLock &operator=(const MutexLock &);
+
+public:
+  MutexLock(Mutex &p_mutex) : m_mutex(p_mutex) { m_mutex.Lock(); }
+  ~MutexLock() { m_mutex.Unlock(); }
+};
+
+/// Lets the parts of a task wait for one another to change the data
+/// guarded by a mutex.  Without thread support, there is no other part
+/// running to wait for, and waiting returns at once.
+class Condition {
+private:
+  struct Rep;
+  Rep *m_rep;
+
+  Condition(const Condition &);
+  Condition &operator=(const Condition &);
+
+public:
+  Condition(void);
+  ~Condition();
+
+  /// Unlocks the mutex, which must be locked, until woken up; then
+  /// locks it again
+  void Wait(Mutex &);
+  /// Wakes up all the parts waiting on the condition
+  void Broadcast(void);
+};
+
+} // end namespace Gambit
+
+#endif // LIBGAMBIT_PARALLEL_H
@@ -33,13 +33,34 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <cmath>
 #include <cfloat>
 #include <cctype>
+#include <climits>
 
 namespace Gambit {
 
 static const Integer _Int_One(1);
 
+namespace {
+
+/// True if p_value is within the range held in the small representation
+inline bool IsSmall(long p_value)
+{ return p_value <= INT_MAX && p_value >= -INT_MAX; }
+
+long LongGCD(long a, long b)
+{
+  while (b != 0) {
+    long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+}  // end anonymous namespace
+
 void Rational::normalize(void)
 {
+  if (m_small) return;
+
   int s = sign(den);
   if (s == 0)  {
     throw ZeroDivideException();
@@ -54,10 +75,67 @@ void Rational::normalize(void)
     num /= g;
     den /= g;
   }
+
+  if (num.fits_in_long() && den.fits_in_long()) {
+    long n = num.as_long(), d = den.as_long();
+    if (IsSmall(n) && IsSmall(d)) {
+      m_small = true;
+      m_num = n;
+      m_den = d;
+    }
+  }
+}
+
+void Rational::SetSmall(long n, long d)
+{
+  if (d == 0) {
+    throw ZeroDivideException();
+  }
+  else if (d < 0) {
+    n = -n;
+    d = -d;
+  }
+
+  long g = LongGCD((n < 0) ? -n : n, d);
+  if (g > 1) {
+    n /= g;
+    d /= g;
+  }
+
+  if (IsSmall(n) && IsSmall(d)) {
+    m_small = true;
+    m_num = n;
+    m_den = d;
+  }
+  else {
+    m_small = false;
+    num = n;
+    den = d;
+  }
+}
+
+const Rational &Rational::Large(Rational &p_scratch) const
+{
+  if (!m_small) return *this;
+  p_scratch.m_small = false;
+  p_scratch.num = m_num;
+  p_scratch.den = m_den;
+  return p_scratch;
 }
 
 void      add(const Rational& x, const Rational& y, Rational& r)
 {
+  if (x.m_small && y.m_small) {
+    r.SetSmall(x.m_num * y.m_den + y.m_num * x.m_den, x.m_den * y.m_den);
+    return;
+  }
+  else if (x.m_small || y.m_small) {
+    Rational xs, ys;
+    add(x.Large(xs), y.Large(ys), r);
+    return;
+  }
+
+  r.m_small = false;
   if (&r != &x && &r != &y)
     {
       mul(x.num, y.den, r.num);
@@ -78,6 +156,17 @@ void      add(const Rational& x, const Rational& y, Rational& r)
 
 void      sub(const Rational& x, const Rational& y, Rational& r)
 {
+  if (x.m_small && y.m_small) {
+    r.SetSmall(x.m_num * y.m_den - y.m_num * x.m_den, x.m_den * y.m_den);
+    return;
+  }
+  else if (x.m_small || y.m_small) {
+    Rational xs, ys;
+    sub(x.Large(xs), y.Large(ys), r);
+    return;
+  }
+
+  r.m_small = false;
   if (&r != &x && &r != &y)
     {
       mul(x.num, y.den, r.num);
@@ -98,6 +187,17 @@ void      sub(const Rational& x, const Rational& y, Rational& r)
 
 void      mul(const Rational& x, const Rational& y, Rational& r)
 {
+  if (x.m_small && y.m_small) {
+    r.SetSmall(x.m_num * y.m_num, x.m_den * y.m_den);
+    return;
+  }
+  else if (x.m_small || y.m_small) {
+    Rational xs, ys;
+    mul(x.Large(xs), y.Large(ys), r);
+    return;
+  }
+
+  r.m_small = false;
   mul(x.num, y.num, r.num);
   mul(x.den, y.den, r.den);
   r.normalize();
@@ -105,6 +205,17 @@ void      mul(const Rational& x, const Rational& y, Rational& r)
 
 void      div(const Rational& x, const Rational& y, Rational& r)
 {
+  if (x.m_small && y.m_small) {
+    r.SetSmall(x.m_num * y.m_den, x.m_den * y.m_num);
+    return;
+  }
+  else if (x.m_small || y.m_small) {
+    Rational xs, ys;
+    div(x.Large(xs), y.Large(ys), r);
+    return;
+  }
+
+  r.m_small = false;
   if (&r != &x && &r != &y)
     {
       mul(x.num, y.den, r.num);
@@ -125,6 +236,16 @@ void      div(const Rational& x, const Rational& y, Rational& r)
 
 void Rational::invert(void)
 {
+  if (m_small) {
+    if (m_num == 0) {
+      throw ZeroDivideException();
+    }
+    long tmp = m_num;
+    m_num = (tmp < 0) ? -m_den : m_den;
+    m_den = (tmp < 0) ? -tmp : tmp;
+    return;
+  }
+
   Integer tmp = num;  
   num = den;  
   den = tmp;  
@@ -140,14 +261,24 @@ void Rational::invert(void)
 
 int compare(const Rational& x, const Rational& y)
 {
-  int xsgn = sign(x.num);
-  int ysgn = sign(y.num);
+  int xsgn = sign(x);
+  int ysgn = sign(y);
   int d = xsgn - ysgn;
-  if (d == 0 && xsgn != 0) d = compare(x.num * y.den, x.den * y.num);
+  if (d == 0 && xsgn != 0) {
+    if (x.m_small && y.m_small) {
+      long a = x.m_num * y.m_den, b = y.m_num * x.m_den;
+      d = (a < b) ? -1 : ((a > b) ? 1 : 0);
+    }
+    else {
+      d = compare(x.numerator() * y.denominator(),
+		  x.denominator() * y.numerator());
+    }
+  }
   return d;
 }
 
 Rational::Rational(double x)
+  : m_small(false), m_num(0), m_den(1)
 {
   num = 0;
   den = 1;
@@ -187,6 +318,7 @@ Rational::Rational(double x)
 
 Integer trunc(const Rational& x)
 {
+  if (x.m_small) return Integer(x.m_num / x.m_den);
   return x.num / x.den ;
 }
 
@@ -205,7 +337,7 @@ Rational Rational::operator-(void) const
 Rational abs(const Rational& x) 
 {
   Rational r(x);
-  if (sign(r.num) < 0) r.negate();
+  if (sign(r) < 0) r.negate();
   return r;
 }
 
@@ -213,9 +345,7 @@ Rational abs(const Rational& x)
 Rational sqr(const Rational& x)
 {
   Rational r;
-  mul(x.num, x.num, r.num);
-  mul(x.den, x.den, r.den);
-  r.normalize();
+  mul(x, x, r);
   return r;
 }
 
@@ -223,8 +353,8 @@ Integer floor(const Rational& x)
 {
   Integer q;
   Integer r;
-  divide(x.num, x.den, q, r);
-  if (sign(x.num) < 0 && sign(r) != 0) --q;
+  divide(x.numerator(), x.denominator(), q, r);
+  if (sign(x) < 0 && sign(r) != 0) --q;
   return q;
 }
 
@@ -232,8 +362,8 @@ Integer ceil(const Rational& x)
 {
   Integer q;
   Integer  r;
-  divide(x.num, x.den, q, r);
-  if (sign(x.num) >= 0 && sign(r) != 0) ++q;
+  divide(x.numerator(), x.denominator(), q, r);
+  if (sign(x) >= 0 && sign(r) != 0) ++q;
   return q;
 }
 
@@ -241,11 +371,11 @@ Integer round(const Rational& x)
 {
   Integer q;
   Integer r;
-  divide(x.num, x.den, q, r);
+  divide(x.numerator(), x.denominator(), q, r);
   r <<= 1;
-  if (ucompare(r, x.den) >= 0)
+  if (ucompare(r, x.denominator()) >= 0)
     {
-      if (sign(x.num) >= 0)
+      if (sign(x) >= 0)
 	++q;
       else
 	--q;
@@ -256,28 +386,29 @@ Integer round(const Rational& x)
 Rational pow(const Rational& x, long y)
 {
   Rational r;
+  r.m_small = false;
   if (y >= 0)
     {
-      pow(x.num, y, r.num);
-      pow(x.den, y, r.den);
+      pow(x.numerator(), y, r.num);
+      pow(x.denominator(), y, r.den);
     }
   else
     {
       y = -y;
-      pow(x.num, y, r.den);
-      pow(x.den, y, r.num);
-      if (sign(r.den) < 0)
-	{
-	  r.num.negate();
-	  r.den.negate();
-	}
+      pow(x.numerator(), y, r.den);
+      pow(x.denominator(), y, r.num);
     }
+  r.normalize();
   return r;
 }
 
 std::ostream &operator << (std::ostream &s, const Rational& y)
 {
-  if (y.denominator() == 1L)
+  if (y.m_small) {
+    s << y.m_num;
+    if (y.m_den != 1) s << "/" << y.m_den;
+  }
+  else if (y.denominator() == 1L)
     s << y.numerator();
   else
     {
@@ -364,6 +495,11 @@ std::istream &operator>>(std::istream &f, Rational &y)
 
 bool Rational::OK(void) const
 {
+  if (m_small) {
+    return (m_den > 0 && IsSmall(m_num) && IsSmall(m_den) &&
+	    LongGCD((m_num < 0) ? -m_num : m_num, m_den) == 1);
+  }
+
   int v = num.OK() && den.OK(); // have valid num and denom
   if (v)   {
     v &= sign(den) > 0;           // denominator positive;
@@ -390,18 +526,49 @@ Rational::fits_in_double() const
 // These were moved from the header file to eliminate warnings
 //
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
+Rational::Rational() : m_small(true), m_num(0), m_den(1) {}
 
-Rational::Rational() : num(&_ZeroRep), den(&_OneRep) {}
-Rational::~Rational() {}
+Rational::Rational(const Integer& n)
+  : m_small(false), m_num(0), m_den(1), num(n), den(1)
+{
+  // An integer is already in lowest terms; only check whether it fits
+  if (n.fits_in_long() && IsSmall(n.as_long())) {
+    m_small = true;
+    m_num = n.as_long();
+  }
+}
+
+Rational::Rational(long n) : m_small(true), m_num(n), m_den(1)
+{
+  if (!IsSmall(n)) {
+    m_small = false;
+    num = n;
+    den = 1;
+  }
+}
+
+Rational::Rational(int n) : m_small(true), m_num(n), m_den(1)
+{
+  if (!IsSmall(n)) {
+    m_small = false;
+    num = n;
+    den = 1;
+  }
+}
 
-Rational::Rational(const Rational& y) :num(y.num), den(y.den) {}
+Rational::~Rational() {}
 
-Rational::Rational(const Integer& n) :num(n), den(&_OneRep) {}
+Rational::Rational(const Rational& y)
+  : m_small(y.m_small), m_num(y.m_num), m_den(y.m_den)
+{
+  if (!m_small) {
+    num = y.num;
+    den = y.den;
+  }
+}
 
 Rational::Rational(const Integer& n, const Integer& d) 
- : num(n), den(d)
+ : m_small(false), m_num(0), m_den(1), num(n), den(d)
 {
   if (d == 0)  {
     throw ZeroDivideException();
@@ -409,41 +576,60 @@ Rational::Rational(const Integer& n, const Integer& d)
   normalize();
 }
 
-Rational::Rational(long n) :num(n), den(&_OneRep) { }
-
-Rational::Rational(int n) :num(n), den(&_OneRep) { }
-
 Rational::Rational(long n, long d) 
- : num(n), den(d)
+ : m_small(false), m_num(0), m_den(1)
 {
   if (d == 0) {
     throw ZeroDivideException();
   }
-  normalize();
+  if (IsSmall(n) && IsSmall(d)) {
+    SetSmall(n, d);
+  }
+  else {
+    num = n;
+    den = d;
+    normalize();
+  }
 }
 
 Rational::Rational(int n, int d) 
- : num(n), den(d) 
+ : m_small(false), m_num(0), m_den(1)
 { 
   if (d == 0) {
     throw ZeroDivideException();
   }
-  normalize(); 
+  if (IsSmall(n) && IsSmall(d)) {
+    SetSmall(n, d);
+  }
+  else {
+    num = n;
+    den = d;
+    normalize();
+  }
 }
 
 Rational &Rational::operator =  (const Rational& y)
 {
-  num = y.num;  den = y.den;   return *this;
+  m_small = y.m_small;
+  m_num = y.m_num;
+  m_den = y.m_den;
+  if (!m_small) {
+    num = y.num;  den = y.den;
+  }
+  return *this;
 }
 
 bool Rational::operator==(const Rational &y) const
 {
+  if (m_small || y.m_small) {
+    return (m_small && y.m_small && m_num == y.m_num && m_den == y.m_den);
+  }
   return compare(num, y.num) == 0 && compare(den, y.den) == 0;
 }
 
 bool Rational::operator!=(const Rational &y) const
 {
-  return compare(num, y.num) != 0 || compare(den, y.den) != 0;
+  return !(*this == y);
 }
 
 bool Rational::operator< (const Rational &y) const
@@ -468,12 +654,18 @@ bool Rational::operator>=(const Rational &y) const
 
 int sign(const Rational& x)
 {
+  if (x.m_small) return (x.m_num > 0) - (x.m_num < 0);
   return sign(x.num);
 }
 
 void Rational::negate()
 {
-  num.negate();
+  if (m_small) {
+    m_num = -m_num;
+  }
+  else {
+    num.negate();
+  }
 }
 
 
@@ -501,11 +693,24 @@ Rational &Rational::operator/=(const Rational& y)
   return *this;
 }
 
-const Integer& Rational::numerator() const { return num; }
-const Integer& Rational::denominator() const { return den; }
+Integer Rational::numerator() const
+{ return (m_small) ? Integer(m_num) : num; }
+
+Integer Rational::denominator() const
+{ return (m_small) ? Integer(m_den) : den; }
 
 Rational::operator double(void) const 
 {
+  if (m_small) {
+    // The same steps as ratio() takes, which are exact in double here
+    long x = (m_num < 0) ? -m_num : m_num;
+    double d = (double) (x / m_den);
+    if (x % m_den != 0) {
+      d += (double) (x % m_den) / (double) m_den;
+    }
+    return (m_num < 0) ? -d : d;
+  }
+
   // We approach this in terms of absolute values because there is
   // (apparently) a bug in ratio() which yields incorrect results
   // for some negative numbers (TLT, 27 Feb 2006).
@@ -36,9 +36,28 @@ namespace Gambit {
 /// A representation of an arbitrary-precision rational number
 class Rational {
 protected:
+  /// @name Representation
+  /// Most values met in games have small numerators and denominators.
+  /// If both fit in an int, they are held in m_num and m_den, and
+  /// m_small is set; sums and products of these can be formed in a
+  /// long without overflow.  Otherwise the value is held in num and
+  /// den.  A value is held small whenever it can be, so each value has
+  /// exactly one representation.
+  //@{
+  bool m_small;
+  long m_num, m_den;
   Integer num, den;
+  //@}
 
+  /// Reduces a value held in num and den to lowest terms, and makes it
+  /// small if it then fits
   void normalize();
+  /// Sets the value to n/d, reducing it to lowest terms.  The arguments
+  /// must be products or sums of products of small values.
+  void SetSmall(long n, long d);
+  /// Returns this value held in num and den, using p_scratch to hold it
+  /// if it is small
+  const Rational &Large(Rational &p_scratch) const;
 
 public:
   Rational(void);
@@ -85,8 +104,8 @@ public:
   friend Rational  sqr(const Rational& x);              // square
   friend Rational  pow(const Rational& x, long y);
   friend Rational  pow(const Rational& x, const Integer& y);
-  const Integer&   numerator() const;
-  const Integer&   denominator() const;
+  Integer          numerator() const;
+  Integer          denominator() const;
 
   // coercion & conversion
 
@@ -22,5 +22,46 @@
 
 #include "lptab.imp"
 
+//
+// The relative cost of a column is the dot product of the dual with the
+// column.  In exact arithmetic, reducing after each term costs a gcd per
+// row; instead, the terms are brought over the common denominator of the
+// dual and summed as integers, and only the result is reduced.
+//
+template<>
+Gambit::Rational LPTableau<Gambit::Rational>::RelativeCost(int col) const
+{
+  if (col < 0) {
+    return unitcost[-col] - dual[-col];
+  }
+
+  Gambit::Vector<Gambit::Rational> tmpcol(MinRow(),MaxRow());
+  TableauInterface<Gambit::Rational>::GetColumn(col, tmpcol);
+
+  Gambit::Integer lcd(1), sum(0), term, den;
+  for (int i = tmpcol.First(); i <= tmpcol.Last(); i++) {
+    if (tmpcol[i] == Gambit::Rational(0)) continue;
+    den = dual[i].denominator();
+    if (den != lcd && lcd % den != 0) {
+      lcd = lcm(den, lcd);
+    }
+  }
+
+  // The columns are scaled by TotDenom(), as in Tableau::GetColumn()
+  Gambit::Integer totdenom(TotDenom());
+  for (int i = tmpcol.First(); i <= tmpcol.Last(); i++) {
+    if (tmpcol[i] == Gambit::Rational(0) || 
+	dual[i] == Gambit::Rational(0)) continue;
+    term = dual[i].numerator();
+    den = dual[i].denominator();
+    if (den != lcd) term *= lcd / den;
+    term *= tmpcol[i].numerator();
+    den = tmpcol[i].denominator();
+    term *= (den == 1) ? totdenom : totdenom / den;
+    sum += term;
+  }
+  return cost[col] - Gambit::Rational(sum, lcd);
+}
+
 template class LPTableau<double>;
 template class LPTableau<Gambit::Rational>;
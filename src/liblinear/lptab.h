@@ -80,4 +80,7 @@ public:
 		   Gambit::Vector<T>&colv) const; 
 };
 
+// The exact version sums over a common denominator; see lptab.cc
+template<> Gambit::Rational LPTableau<Gambit::Rational>::RelativeCost(int) const;
+
 #endif     // LPTAB_H
@@ -22,6 +22,12 @@
 
 #include "ludecomp.imp"
 
+Gambit::Mutex &LUdecompCopyLock(void)
+{
+  static Gambit::Mutex lock;
+  return lock;
+}
+
 template class EtaMatrix<double>;
 template class LUdecomp<double>;
 
@@ -23,27 +23,35 @@
 #ifndef LUDECOMP_H
 #define LUDECOMP_H
 
+#include <vector>
+
 #include "libgambit/libgambit.h"
+#include "libgambit/parallel.h"
 #include "basis.h"
 
 template <class T> class Tableau;
 
+// The lock held while changing the count of copies of a decomposition,
+// since copies on different threads may share the one they copy
+Gambit::Mutex &LUdecompCopyLock(void);
+
 // ---------------------------------------------------------------------------
 // Class EtaMatrix
 // ---------------------------------------------------------------------------
 
+//
+// An eta matrix is the identity matrix with one column replaced.  Only
+// the nonzero entries of that column are kept, which is most of the
+// saving when the tableau is sparse, as for the sequence form.
+//
 template <class T> class EtaMatrix {
   public:
   int col;
-  Gambit::Vector<T> etadata;
-  
-  
-  EtaMatrix(int c, Gambit::Vector<T> &v) : col(c), etadata(v) {};
-
-// required for list class
-bool operator==(const EtaMatrix<T> &) const;
-bool operator!=(const EtaMatrix<T> &) const;
+  T pivot;                      // the entry of the column on the diagonal
+  Gambit::Array<int> rows;      // the rows of the other nonzero entries
+  Gambit::Array<T> values;      // and their values, in increasing row order
 
+  EtaMatrix(int c, const Gambit::Vector<T> &v);
 };
 
 // ---------------------------------------------------------------------------
@@ -57,10 +65,10 @@ private:
   Tableau<T> &tab;
   Basis &basis;
 
-  Gambit::List< EtaMatrix<T> > L;
-  Gambit::List< EtaMatrix<T> > U;
-  Gambit::List< EtaMatrix<T> > E;
-  Gambit::List< int > P;
+  std::vector< EtaMatrix<T> > L;
+  std::vector< EtaMatrix<T> > U;
+  std::vector< EtaMatrix<T> > E;
+  std::vector< int > P;
 
   Gambit::Vector<T> scratch1; // scratch vectors so we don't reallocate them
   Gambit::Vector<T> scratch2; // everytime we do something.
@@ -72,6 +80,8 @@ private:
   const LUdecomp<T> *parent;
   int copycount;
 
+  void ChangeParentCount(int) const;
+
   // don't use this copy constructor
   LUdecomp( const LUdecomp<T> &a);
   // don't use the equals operator, use the Copy function instead
@@ -153,18 +163,11 @@ private:
   void LPd_Trans( Gambit::Vector<T> & ) const;
   void yLP_Trans( Gambit::Vector<T> & ) const;
 
-  void VectorEtaSolve( const Gambit::Vector<T> &v,  
-		      const EtaMatrix<T> &, 
-		      Gambit::Vector<T> &y ) const;
-
-  void EtaVectorSolve( const Gambit::Vector<T> &v, 
-		      const EtaMatrix<T> &,
-		      Gambit::Vector<T> &d ) const;
-
-  void yLP_mult( const Gambit::Vector<T> &y, int j, Gambit::Vector<T> &) const;
-
-  void LPd_mult( Gambit::Vector<T> &d, int j, Gambit::Vector<T> &) const;
+  void VectorEtaSolve( const EtaMatrix<T> &, Gambit::Vector<T> &y ) const;
+  void EtaVectorSolve( const EtaMatrix<T> &, Gambit::Vector<T> &d ) const;
 
+  void yLP_mult( int j, Gambit::Vector<T> &y ) const;
+  void LPd_mult( int j, Gambit::Vector<T> &d ) const;
 
 };  // end of class LUdecomp
     
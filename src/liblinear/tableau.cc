@@ -190,6 +190,32 @@ Gambit::Integer find_lcd(const Gambit::Vector<Gambit::Rational> &vec)
   return lcd;
 }
 
+//
+// Sets out = inv * vec, for an integer matrix.  The product is formed
+// over the common denominator of vec, and must come out integral.
+//
+void IntMultiply(const Gambit::Matrix<Gambit::Integer> &inv,
+		 const Gambit::Vector<Gambit::Rational> &vec,
+		 Gambit::Vector<Gambit::Integer> &out)
+{
+  Gambit::Integer lcd(find_lcd(vec)), scale, prod, quot, rem;
+  out = Gambit::Integer(0);
+  for(int j=vec.First();j<=vec.Last();j++) {
+    if(vec[j] == Gambit::Rational(0)) continue;
+    scale = vec[j].numerator()*(lcd/vec[j].denominator());
+    for(int i=out.First();i<=out.Last();i++) {
+      mul(inv(i,j),scale,prod);
+      out[i] += prod;
+    }
+  }
+  if(lcd == 1) return;
+  for(int i=out.First();i<=out.Last();i++) {
+    divide(out[i],lcd,quot,rem);
+    if(rem != 0) throw Tableau<Gambit::Rational>::BadDenom();
+    out[i] = quot;
+  }
+}
+
 // Constructors and Destructor
  
 Tableau<Gambit::Rational>::Tableau(const Gambit::Matrix<Gambit::Rational> &A, 
@@ -350,15 +376,30 @@ void Tableau<Gambit::Rational>::Pivot(int outrow,int in_col)
   // 4: d=Ci*j* (done last)
 
   // Step 3
+  // The division by d is exact.  The products are formed in place, since
+  // the temporaries would otherwise dominate on large tableaus.
   
+  Gambit::Integer pivot(Tabdat(row,col)), factor, prod, cross;
   for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
     if(i!=row){
+      factor = Tabdat(i,col);
+      bool zero = (factor == 0);
       for(j=Tabdat.MinCol();j<=Tabdat.MaxCol();++j){
 	if(j!=col){
-	  Tabdat(i,j) = (Tabdat(row,col)*Tabdat(i,j)-Tabdat(row,j)*Tabdat(i,col))/denom;
+	  mul(pivot,Tabdat(i,j),prod);
+	  if(!zero) {
+	    mul(Tabdat(row,j),factor,cross);
+	    prod -= cross;
+	  }
+	  div(prod,denom,Tabdat(i,j));
 	}
       }
-      Coeff[i] = (Tabdat(row,col)*Coeff[i]-Coeff[row]*Tabdat(i,col))/denom;
+      mul(pivot,Coeff[i],prod);
+      if(!zero) {
+	mul(Coeff[row],factor,cross);
+	prod -= cross;
+      }
+      div(prod,denom,Coeff[i]);
     }
   }
   // Step 2
@@ -412,15 +453,26 @@ void Tableau<Gambit::Rational>::SolveColumn(int in_col, Gambit::Vector<Gambit::R
 void Tableau<Gambit::Rational>::MySolveColumn(int in_col, Gambit::Vector<Gambit::Rational> &out)
 {
   Gambit::Vector<Gambit::Integer> tempcol(tmpcol.First(),tmpcol.Last());
+  IntSolveColumn(in_col, tempcol);
+  for(int i=tempcol.First();i<=tempcol.Last();i++)
+    out[i] = Gambit::Rational(tempcol[i]);
+}
+
+//
+// The column of the tableau for in_col, scaled by abs(denom) as in
+// MySolveColumn, but left as integers.  Callers that combine several
+// columns accumulate on these and reduce only the final results.
+//
+void Tableau<Gambit::Rational>::IntSolveColumn(int in_col, Gambit::Vector<Gambit::Integer> &out) const
+{
   if(Member(in_col)) {
-    out = (Gambit::Rational)0;
-    out[Find(in_col)] = Gambit::Rational(abs(denom));
+    out = Gambit::Integer(0);
+    out[Find(in_col)] = abs(denom);
   }
   else {
-    int col = remap(in_col);
-    Tabdat.GetColumn(col,tempcol);
-    for(int i=tempcol.First();i<=tempcol.Last();i++)
-      out[i] = (Gambit::Rational)(tempcol[i]) * (Gambit::Rational)(sign(denom*totdenom));
+    Tabdat.GetColumn(remap(in_col),out);
+    if(sign(denom*totdenom) < 0)
+      for(int i=out.First();i<=out.Last();i++) out[i].negate();
   }
 }
 
@@ -442,33 +494,27 @@ void Tableau<Gambit::Rational>::Refactor()
   // gout << "\ndenom: " << denom << " totdenom: " << totdenom;
 
   int i,j;
-  Gambit::Matrix<Gambit::Rational> inv(GetInverse());
-  Gambit::Matrix<Gambit::Rational> Tabnew(Tabdat.MinRow(),Tabdat.MaxRow(),Tabdat.MinCol(),Tabdat.MaxCol());
-  for(i=nonbasic.First();i<=nonbasic.Last();i++) {
-    GetColumn(nonbasic[i],mytmpcol);
-    //    if(nonbasic[i]>=0) mytmpcol*=Gambit::Rational(totdenom);
-    Tabnew.SetColumn(i,inv * mytmpcol * (Gambit::Rational)sign(denom*totdenom));
-    //gout << "\nMyTmpCol \n" << mytmpcol;
+  Gambit::Matrix<Gambit::Integer> inv(MinRow(),MaxRow(),MinRow(),MaxRow());
+  Gambit::Vector<Gambit::Integer> intcol(MinRow(),MaxRow());
+  for(i=inv.MinCol();i<=inv.MaxCol();i++) {
+    IntSolveColumn(-i,intcol);
+    inv.SetColumn(i,intcol);
   }
+  bool negate = (sign(denom*totdenom) < 0);
 
-  //gout << "\nInv: \n" << inv;
-  //gout << "\nTabdat:\n" << Tabdat;
-  //gout << "\nTabnew:\n" << Tabnew;
-
-  Gambit::Vector<Gambit::Rational> Coeffnew(Coeff.First(),Coeff.Last());
-  Coeffnew = inv * (*b) * totdenom * (Gambit::Rational)sign(denom*totdenom);
-
-  //gout << "\nCoeff:\n" << Coeff;
-  //gout << "\nCoeffew:\n" << Coeffnew;
-
-  for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();i++) {
-    if(Coeffnew[i].denominator() != 1) throw BadDenom();
-    Coeff[i] = Coeffnew[i].numerator();
-    for(j=Tabdat.MinCol();j<=Tabdat.MaxCol();j++) {
-      if(Tabnew(i,j).denominator() != 1) throw BadDenom();
-      Tabdat(i,j) = Tabnew(i,j).numerator();
+  for(i=nonbasic.First();i<=nonbasic.Last();i++) {
+    GetColumn(nonbasic[i],mytmpcol);
+    IntMultiply(inv,mytmpcol,intcol);
+    for(j=Tabdat.MinRow();j<=Tabdat.MaxRow();j++) {
+      if(negate) intcol[j].negate();
+      Tabdat(j,i) = intcol[j];
     }
   }
+
+  mytmpcol = (*b) * (Gambit::Rational)totdenom;
+  IntMultiply(inv,mytmpcol,Coeff);
+  if(negate)
+    for(i=Coeff.First();i<=Coeff.Last();i++) Coeff[i].negate();
   //BigDump(gout);
 }
   
@@ -494,15 +540,45 @@ void Tableau<Gambit::Rational>::SetBasis(const Basis &in)
  // solve M x = b
 void Tableau<Gambit::Rational>::Solve(const Gambit::Vector<Gambit::Rational> &b, Gambit::Vector<Gambit::Rational> &x)
 {
-  // Here, we do x = V * b, where V = M inverse
-  x = (GetInverse() * b )/(Gambit::Rational)abs(denom);
+  // Here, we do x = V * b, where V = M inverse.  The columns of V are
+  // integers over abs(denom); clearing the denominators of b as well
+  // lets the sums be formed in integers, reducing each entry once.
+  Gambit::Integer lcd(find_lcd(b)), scale, prod;
+  Gambit::Vector<Gambit::Integer> col(MinRow(),MaxRow()), sum(MinRow(),MaxRow());
+  sum = Gambit::Integer(0);
+  for(int j=b.First();j<=b.Last();j++) {
+    if(b[j] == Gambit::Rational(0)) continue;
+    scale = b[j].numerator()*(lcd/b[j].denominator());
+    IntSolveColumn(-j,col);
+    for(int i=sum.First();i<=sum.Last();i++) {
+      mul(col[i],scale,prod);
+      sum[i] += prod;
+    }
+  }
+  lcd *= abs(denom);
+  for(int i=x.First();i<=x.Last();i++)
+    x[i] = Gambit::Rational(sum[i],lcd);
 }
 
  // solve y M = c
 void Tableau<Gambit::Rational>::SolveT(const Gambit::Vector<Gambit::Rational> &c, Gambit::Vector<Gambit::Rational> &y)
 {
-  // Here we do y = c * V, where V = M inverse
-  y = (c * GetInverse()) /(Gambit::Rational)abs(denom);
+  // Here we do y = c * V, where V = M inverse, in integers as in Solve()
+  Gambit::Integer lcd(find_lcd(c)), sum, prod;
+  Gambit::Vector<Gambit::Integer> scaled(c.First(),c.Last()), col(MinRow(),MaxRow());
+  for(int i=c.First();i<=c.Last();i++)
+    scaled[i] = c[i].numerator()*(lcd/c[i].denominator());
+  Gambit::Integer total(lcd*abs(denom));
+  for(int j=y.First();j<=y.Last();j++) {
+    IntSolveColumn(-j,col);
+    sum = 0;
+    for(int i=col.First();i<=col.Last();i++) {
+      if(scaled[i] == 0) continue;
+      mul(scaled[i],col[i],prod);
+      sum += prod;
+    }
+    y[j] = Gambit::Rational(sum,total);
+  }
 }
 
 bool Tableau<Gambit::Rational>::IsFeasible()
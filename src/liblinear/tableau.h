@@ -93,6 +93,7 @@ private:
   Gambit::Vector<Gambit::Rational> tmpcol; // temporary column vector, to avoid allocation
 
   void MySolveColumn(int, Gambit::Vector<Gambit::Rational> &);  // column in new basis 
+  void IntSolveColumn(int, Gambit::Vector<Gambit::Integer> &) const;  // same, unconverted
 
 protected:
   Gambit::Array<int> nonbasic;     //** nonbasic variables -- should be moved to Basis
@@ -328,9 +328,11 @@ cdef class Game:
         return self
 
     def write(self, format='native'):
-        cdef cxx_string s
+        cdef cxx_string s, text
         if format == 'gte':
             return gambit.gte.write_game(self)
         else:
             s.assign(format)
-            return WriteGame(self.game, s).c_str()
+            text = WriteGame(self.game, s)
+            # Binary savefiles may contain null characters
+            return text.c_str()[:text.size()]
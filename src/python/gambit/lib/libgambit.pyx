@@ -33,6 +33,7 @@ __version__ = VERSION
 cdef extern from "string":
     cdef cppclass cxx_string "string":
         char *c_str()
+        int size()
         cxx_string assign(char *)
 
 cdef extern from "libgambit/rational.h":
@@ -327,7 +328,7 @@ cdef extern from "libgambit/stratspt.h":
 
 cdef extern from "util.h":
     c_Game ReadGame(char *) except +IOError
-    c_Game ParseGame(char *) except +IOError
+    c_Game ParseGame(char *, int) except +IOError
     cxx_string WriteGame(c_Game, cxx_string) except +IOError
     cxx_string WriteGame(c_StrategySupport) except +IOError
 
@@ -415,5 +416,5 @@ def read_game(char *fn):
 def parse_game(char *s):
     cdef Game g
     g = Game()
-    g.game = ParseGame(s)
+    g.game = ParseGame(s, len(s))
     return g
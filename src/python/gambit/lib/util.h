@@ -39,13 +39,13 @@ inline Game NewTable(Array<int> *dim)
 
 Game ReadGame(char *fn) throw (InvalidFileException)
 { 
-  std::ifstream f(fn);
+  std::ifstream f(fn, std::ios::in | std::ios::binary);
   return Gambit::ReadGame(f);
 }
 
-Game ParseGame(char *s) throw (InvalidFileException)
+Game ParseGame(char *s, int length) throw (InvalidFileException)
 {
-  std::istringstream f(s);
+  std::istringstream f(std::string(s, length));
   return Gambit::ReadGame(f);
 }
 
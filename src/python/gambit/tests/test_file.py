@@ -81,3 +81,21 @@ class TestGambitNfgFile(object):
         nose.tools.assert_equal(str(e.exception),
                                 "line 1:73: Not enough players for number of strategy entries")
 
+
+class TestGambitBinaryFile(object):
+    def test_table_round_trip(self):
+        g = gambit.read_game("test_games/payoff_game.nfg")
+        h = gambit.parse_game(g.write("binary"))
+        nose.tools.assert_equal(h.write("native"), g.write("native"))
+
+    def test_tree_round_trip(self):
+        g = gambit.read_game("test_games/complicated_extensive_game.efg")
+        h = gambit.parse_game(g.write("binary"))
+        nose.tools.assert_equal(h.write("native"), g.write("native"))
+
+    def test_parse_string_truncated(self):
+        g = gambit.read_game("test_games/payoff_game.nfg")
+        with nose.tools.assert_raises(IOError) as e:
+            gambit.parse_game(g.write("binary")[:-1])
+        nose.tools.assert_equal(str(e.exception),
+                                "Unexpected end of binary game file")
@@ -32,13 +32,23 @@ if 'setuptools.extension' in sys.modules:
     m.Extension.__dict__ = m._Extension.__dict__
     
 import glob
+
+# Link against GNU MP if the library was configured to use it
+libraries = [ ]
+try:
+    if "#define USE_GMP 1" in open("../../config.h").read():
+        libraries.append("gmp")
+except IOError:
+    pass
+
 libgame = Extension("gambit.lib.libgambit",
                     sources=[ "gambit/lib/libgambit.pyx" ] +
                             glob.glob("gambit/lib/*.pxi") +
                             glob.glob("../libgambit/*.cc") +
                             glob.glob("../libagg/*.cc"),
                     language="c++",
-                    include_dirs=[ "../..", ".." ] )
+                    include_dirs=[ "../..", ".." ],
+                    libraries=libraries )
 
 setup(name="gambit",
       version="14.0.1",
@@ -0,0 +1,236 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/bench/exact.cc
+// Microbenchmark of exact (rational) arithmetic on games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <getopt.h>
+#include <iostream>
+#include <fstream>
+#include "libgambit/libgambit.h"
+#include "libgambit/sqmatrix.h"
+
+using namespace Gambit;
+
+//
+// The benchmarks exercise the arithmetic which dominates the exact
+// solvers: sums of products of fractions with unrelated denominators,
+// and elimination on matrices of payoffs.  Running the same games
+// through a build configured --with-gmp and one without compares the
+// two implementations of Integer.  Each benchmark makes one pass, and
+// returns the number of operations it timed.
+//
+namespace {
+
+volatile double sink = 0.0;
+
+class Benchmark {
+public:
+  virtual ~Benchmark() { }
+  virtual long Pass(void) = 0;
+};
+
+//
+// Payoffs at a profile in which each player's strategies get distinct
+// probabilities, so that the denominators do not cancel
+//
+MixedStrategyProfile<Rational> SkewedProfile(const Game &p_game)
+{
+  MixedStrategyProfile<Rational> profile =
+    p_game->NewMixedStrategyProfile(Rational(0));
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    int n = player->NumStrategies();
+    Integer total(n * (n + 1) / 2 + n * (pl + 1));
+    for (int st = 1; st <= n; st++) {
+      profile[player->GetStrategy(st)] = Rational(Integer(st + pl + 1), total);
+    }
+  }
+  return profile;
+}
+
+class MixedPayoffs : public Benchmark {
+private:
+  MixedStrategyProfile<Rational> m_profile;
+public:
+  MixedPayoffs(const Game &p_game) : m_profile(SkewedProfile(p_game)) { }
+  virtual ~MixedPayoffs() { }
+  virtual long Pass(void)
+  {
+    int numPlayers = m_profile.GetGame()->NumPlayers();
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      sink += (double) m_profile.GetPayoff(pl);
+    }
+    return numPlayers;
+  }
+};
+
+class MixedDerivs : public Benchmark {
+private:
+  MixedStrategyProfile<Rational> m_profile;
+  Array<GameStrategy> m_strategies;
+public:
+  MixedDerivs(const Game &p_game) : m_profile(SkewedProfile(p_game))
+  {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      GamePlayer player = p_game->GetPlayer(pl);
+      for (int st = 1; st <= player->NumStrategies(); st++) {
+	m_strategies.Append(player->GetStrategy(st));
+      }
+    }
+  }
+  virtual ~MixedDerivs() { }
+  virtual long Pass(void)
+  {
+    for (int i = 1; i <= m_strategies.Length(); i++) {
+      const GameStrategy &strategy = m_strategies[i];
+      sink += (double) m_profile.GetPayoffDeriv(strategy->GetPlayer()->GetNumber(),
+						 strategy);
+    }
+    return m_strategies.Length();
+  }
+};
+
+//
+// The determinant of the leading square block of the first player's
+// payoffs in a two-player game, with the strategies of the second
+// player weighted by distinct fractions.  This is the pivoting done by
+// enummixed and the exact tableaus, without the search around it.
+//
+class Determinant : public Benchmark {
+private:
+  SquareMatrix<Rational> m_matrix;
+public:
+  Determinant(const Game &p_game, int p_size);
+  virtual ~Determinant() { }
+  virtual long Pass(void)
+  {
+    sink += (double) m_matrix.Determinant();
+    return 1;
+  }
+};
+
+Determinant::Determinant(const Game &p_game, int p_size)
+  : m_matrix(p_size)
+{
+  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
+  GamePlayer row = p_game->GetPlayer(1), col = p_game->GetPlayer(2);
+  for (int i = 1; i <= p_size; i++) {
+    profile->SetStrategy(row->GetStrategy(i));
+    for (int j = 1; j <= p_size; j++) {
+      profile->SetStrategy(col->GetStrategy(j));
+      m_matrix(i, j) = (profile->GetPayoff(1) + Rational(i)) *
+	Rational(Integer(1), Integer(j + 1));
+    }
+  }
+}
+
+//
+// Repeats the benchmark until at least p_seconds of processor time
+// have elapsed, and reports the average time per operation.
+//
+void Run(const std::string &p_file, const std::string &p_name,
+	 Benchmark *p_bench, double p_seconds)
+{
+  long calls = 0;
+  std::clock_t start = std::clock(), elapsed;
+  do {
+    calls += p_bench->Pass();
+    elapsed = std::clock() - start;
+  } while (elapsed < p_seconds * CLOCKS_PER_SEC);
+  delete p_bench;
+
+  double seconds = (double) elapsed / (double) CLOCKS_PER_SEC;
+  std::cout << p_file << '\t' << p_name << '\t' << calls << '\t'
+	    << 1.0e9 * seconds / (double) calls << std::endl;
+}
+
+void PrintHelp(char *progname)
+{
+  std::cerr << "Time exact arithmetic on games\n";
+  std::cerr << "Usage: " << progname << " [OPTIONS] FILE...\n";
+  std::cerr << "Options:\n";
+  std::cerr << "  -t SECONDS       minimum processor time per benchmark (default 0.5)\n";
+  std::cerr << "  -h               print this help message\n";
+  std::cerr << "Output is one line per game and benchmark: the file, the benchmark,\n";
+  std::cerr << "the number of operations made, and the average nanoseconds per operation.\n";
+  exit(1);
+}
+
+}  // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+  opterr = 0;
+  double seconds = 0.5;
+
+  int c;
+  while ((c = getopt(argc, argv, "t:h")) != -1) {
+    switch (c) {
+    case 't':
+      seconds = atof(optarg);
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (optind >= argc) {
+    PrintHelp(argv[0]);
+  }
+
+  std::cout << "file\tbenchmark\toperations\tns/operation\n";
+  for (int i = optind; i < argc; i++) {
+    std::ifstream file_stream(argv[i]);
+    if (!file_stream.is_open()) {
+      std::cerr << argv[0] << ": " << argv[i] << ": cannot open file\n";
+      continue;
+    }
+
+    try {
+      Game game = ReadGame(file_stream);
+      Run(argv[i], "mixed-payoff", new MixedPayoffs(game), seconds);
+      Run(argv[i], "mixed-deriv", new MixedDerivs(game), seconds);
+      if (game->NumPlayers() == 2) {
+	int size = std::min(game->GetPlayer(1)->NumStrategies(),
+			    game->GetPlayer(2)->NumStrategies());
+	Run(argv[i], "determinant", new Determinant(game, size), seconds);
+      }
+    }
+    catch (InvalidFileException) {
+      std::cerr << argv[0] << ": " << argv[i] << ": game not in a recognized format\n";
+    }
+  }
+
+  return 0;
+}
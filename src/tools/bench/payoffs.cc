@@ -0,0 +1,218 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2013, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/bench/payoffs.cc
+// Microbenchmark of payoff computations on strategic games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstdlib>
+#include <ctime>
+#include <getopt.h>
+#include <iostream>
+#include <fstream>
+#include "libgambit/libgambit.h"
+
+using namespace Gambit;
+
+//
+// Each benchmark makes one pass over the game, and returns the number
+// of payoff queries it made.  Any profile used is set up beforehand, so
+// only the queries are timed.  Results are accumulated into a volatile
+// sink so the queries cannot be optimized away.
+//
+namespace {
+
+volatile double sink = 0.0;
+
+class Benchmark {
+public:
+  virtual ~Benchmark() { }
+  virtual long Pass(void) = 0;
+};
+
+class PurePayoffs : public Benchmark {
+private:
+  Game m_game;
+public:
+  PurePayoffs(const Game &p_game) : m_game(p_game) { }
+  virtual ~PurePayoffs() { }
+  virtual long Pass(void)
+  {
+    long calls = 0;
+    for (StrategyIterator citer(m_game); !citer.AtEnd(); citer++) {
+      for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+	sink += (*citer)->GetPayoff(pl);
+	calls++;
+      }
+    }
+    return calls;
+  }
+};
+
+class PureNash : public Benchmark {
+private:
+  Game m_game;
+public:
+  PureNash(const Game &p_game) : m_game(p_game) { }
+  virtual ~PureNash() { }
+  virtual long Pass(void)
+  {
+    long calls = 0;
+    for (StrategyIterator citer(m_game); !citer.AtEnd(); citer++) {
+      if ((*citer)->IsNash())  sink += 1.0;
+      calls++;
+    }
+    return calls;
+  }
+};
+
+class MixedPayoffs : public Benchmark {
+private:
+  MixedStrategyProfile<double> m_profile;
+public:
+  MixedPayoffs(const Game &p_game)
+    : m_profile(p_game->NewMixedStrategyProfile(0.0)) { }
+  virtual ~MixedPayoffs() { }
+  virtual long Pass(void)
+  {
+    int numPlayers = m_profile.GetGame()->NumPlayers();
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      sink += m_profile.GetPayoff(pl);
+    }
+    return numPlayers;
+  }
+};
+
+class MixedDerivs : public Benchmark {
+private:
+  MixedStrategyProfile<double> m_profile;
+  Array<GameStrategy> m_strategies;
+public:
+  MixedDerivs(const Game &p_game)
+    : m_profile(p_game->NewMixedStrategyProfile(0.0))
+  {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      GamePlayer player = p_game->GetPlayer(pl);
+      for (int st = 1; st <= player->NumStrategies(); st++) {
+	m_strategies.Append(player->GetStrategy(st));
+      }
+    }
+  }
+  virtual ~MixedDerivs() { }
+  virtual long Pass(void)
+  {
+    for (int i = 1; i <= m_strategies.Length(); i++) {
+      const GameStrategy &strategy = m_strategies[i];
+      sink += m_profile.GetPayoffDeriv(strategy->GetPlayer()->GetNumber(),
+				       strategy);
+    }
+    return m_strategies.Length();
+  }
+};
+
+//
+// Repeats the benchmark until at least p_seconds of processor time
+// have elapsed, and reports the average time per query.
+//
+void Run(const std::string &p_file, const std::string &p_name,
+	 Benchmark *p_bench, double p_seconds)
+{
+  long calls = 0;
+  std::clock_t start = std::clock(), elapsed;
+  do {
+    calls += p_bench->Pass();
+    elapsed = std::clock() - start;
+  } while (elapsed < p_seconds * CLOCKS_PER_SEC);
+  delete p_bench;
+
+  double seconds = (double) elapsed / (double) CLOCKS_PER_SEC;
+  std::cout << p_file << '\t' << p_name << '\t' << calls << '\t'
+	    << 1.0e9 * seconds / (double) calls << std::endl;
+}
+
+void PrintHelp(char *progname)
+{
+  std::cerr << "Time payoff computations on strategic games\n";
+  std::cerr << "Usage: " << progname << " [OPTIONS] FILE...\n";
+  std::cerr << "Options:\n";
+  std::cerr << "  -t SECONDS       minimum processor time per benchmark (default 0.5)\n";
+  std::cerr << "  -h               print this help message\n";
+  std::cerr << "Output is one line per game and benchmark: the file, the benchmark,\n";
+  std::cerr << "the number of queries made, and the average nanoseconds per query.\n";
+  exit(1);
+}
+
+}  // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+  opterr = 0;
+  double seconds = 0.5;
+
+  int c;
+  while ((c = getopt(argc, argv, "t:h")) != -1) {
+    switch (c) {
+    case 't':
+      seconds = atof(optarg);
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (optind >= argc) {
+    PrintHelp(argv[0]);
+  }
+
+  std::cout << "file\tbenchmark\tqueries\tns/query\n";
+  for (int i = optind; i < argc; i++) {
+    std::ifstream file_stream(argv[i]);
+    if (!file_stream.is_open()) {
+      std::cerr << argv[0] << ": " << argv[i] << ": cannot open file\n";
+      continue;
+    }
+
+    try {
+      Game game = ReadGame(file_stream);
+      if (game->IsTree()) {
+	std::cerr << argv[0] << ": " << argv[i] << ": not a strategic game\n";
+	continue;
+      }
+      Run(argv[i], "pure-payoff", new PurePayoffs(game), seconds);
+      Run(argv[i], "pure-nash", new PureNash(game), seconds);
+      Run(argv[i], "mixed-payoff", new MixedPayoffs(game), seconds);
+      Run(argv[i], "mixed-deriv", new MixedDerivs(game), seconds);
+    }
+    catch (InvalidFileException) {
+      std::cerr << argv[0] << ": " << argv[i] << ": game not in a recognized format\n";
+    }
+  }
+
+  return 0;
+}
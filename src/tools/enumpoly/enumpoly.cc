@@ -30,6 +30,7 @@
 #include "nfghs.h"
 
 int g_numDecimals = 6;
+int g_numThreads = 1;
 bool g_verbose = false;
 
 void PrintBanner(std::ostream &p_stream)
@@ -50,6 +51,7 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibrium probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       number of threads to use on strategic games (default 1)\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
@@ -78,7 +80,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHj:SqvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -91,6 +93,13 @@ int main(int argc, char *argv[])
     case 'H':
       useHeuristic = true;
       break;
+    case 'j':
+      g_numThreads = atoi(optarg);
+      if (g_numThreads < 1) {
+	std::cerr << argv[0] << ": Number of threads must be positive.\n";
+	return 1;
+      }
+      break;
     case 'S':
       useStrategic = true;
       break;
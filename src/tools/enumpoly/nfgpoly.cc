@@ -21,16 +21,18 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 
+#include "libgambit/parallel.h"
 #include "nfgensup.h"
 #include "gpoly.h"
 #include "gpolylst.h"
 #include "rectangl.h"
 #include "quiksolv.h"
 
-extern int g_numDecimals;
+extern int g_numDecimals, g_numThreads;
 extern bool g_verbose; 
 
 class PolEnumModule  {
@@ -43,6 +45,8 @@ private:
   int num_vars;
   long nevals;
   double time;
+  gPolyList<double> equations;
+  Gambit::List<Gambit::Vector<double> > roots;
   Gambit::List<Gambit::MixedStrategyProfile<double> > solutions;
   bool is_singular;
 
@@ -66,6 +70,12 @@ public:
   PolEnumModule(const Gambit::StrategySupport &);
   
   int PolEnum(void);
+
+  // The steps of PolEnum().  Only FindRoots() does not use the game,
+  // so it may run for several supports at once on different threads.
+  void SetUpEquations(void);
+  void FindRoots(void);
+  int SaveRoots(void);
   
   long NumEvals(void) const;
   double Time(void) const;
@@ -88,7 +98,7 @@ PolEnumModule::PolEnumModule(const Gambit::StrategySupport &S)
   : NF(S.GetGame()), support(S),
     Space(support.MixedProfileLength()-NF->NumPlayers()), 
     Lex(&Space, lex), num_vars(support.MixedProfileLength()-NF->NumPlayers()), 
-    nevals(0), is_singular(false)
+    nevals(0), equations(&Space, &Lex), is_singular(false)
 { 
 //  Gambit::Epsilon(eps,12);
 }
@@ -96,7 +106,14 @@ PolEnumModule::PolEnumModule(const Gambit::StrategySupport &S)
 
 int PolEnumModule::PolEnum(void)
 {
-  gPolyList<double> equations = NashOnSupportEquationsAndInequalities();
+  SetUpEquations();
+  FindRoots();
+  return SaveRoots();
+}
+
+void PolEnumModule::SetUpEquations(void)
+{
+  equations = NashOnSupportEquationsAndInequalities();
 
   /*
   // equations for equality of strat j to strat j+1
@@ -108,7 +125,10 @@ int PolEnumModule::PolEnum(void)
     if(support.NumStrats(i)>2) 
       equations+=Prob(i,support.NumStrats(i));
   */
+}
 
+void PolEnumModule::FindRoots(void)
+{
   // set up the rectangle of search
   Gambit::Vector<double> bottoms(num_vars), tops(num_vars);
   bottoms = (double)0;
@@ -117,11 +137,12 @@ int PolEnumModule::PolEnum(void)
   gRectangle<double> Cube(bottoms, tops); 
 
   // start QuikSolv
-  Gambit::List<Gambit::Vector<double> > solutionlist = NashOnSupportSolnVectors(equations,
-								   Cube);
+  roots = NashOnSupportSolnVectors(equations, Cube);
+}
 
-  int index = SaveSolutions(solutionlist);
-  return index;	 
+int PolEnumModule::SaveRoots(void)
+{
+  return SaveSolutions(roots);
 }
 
 int PolEnumModule::SaveSolutions(const Gambit::List<Gambit::Vector<double> > &list)
@@ -478,37 +499,118 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveStrategic(const Gambit::Game &p_nfg)
-{
-  Gambit::List<Gambit::StrategySupport> supports = PossibleNashSubsupports(p_nfg);
+namespace {
 
-  for (int i = 1; i <= supports.Length(); i++) {
-    long newevals = 0;
-    double newtime = 0.0;
-    Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
-    bool is_singular = false;
-    
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
-    }
+//
+// Finds the roots of the polynomial systems of a range of supports.
+// The systems are set up beforehand, and the threads take the next
+// support not yet started, since the time to solve a system varies
+// widely from one support to the next.
+//
+class FindRootsTask : public Gambit::ParallelTask {
+private:
+  Gambit::Array<PolEnumModule *> &m_modules;
+  Gambit::Mutex m_mutex;
+  int m_next;
 
-    PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
-      
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue() < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+public:
+  FindRootsTask(Gambit::Array<PolEnumModule *> &p_modules)
+    : m_modules(p_modules), m_next(1) { }
+  virtual ~FindRootsTask() { }
+
+  virtual void Run(int, int)
+  {
+    while (true) {
+      int index;
+      {
+	Gambit::MutexLock lock(m_mutex);
+	if (m_next > m_modules.Length()) return;
+	index = m_next++;
       }
+      m_modules[index]->FindRoots();
     }
+  }
+};
 
-    if (is_singular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+//
+// Equilibria on a support which is singular may also be found on the
+// supports inside it; these are reported only once.
+//
+bool IsSameProfile(const Gambit::MixedStrategyProfile<double> &p_profile1,
+		   const Gambit::MixedStrategyProfile<double> &p_profile2)
+{
+  for (int i = 1; i <= p_profile1.MixedProfileLength(); i++) {
+    if (std::fabs(p_profile1[i] - p_profile2[i]) > 1.0e-6) {
+      return false;
     }
   }
+  return true;
 }
 
+// Number of supports to set up at a time, per thread
+const int SUPPORTS_PER_THREAD = 16;
 
+}  // end anonymous namespace
 
+//
+// The supports are solved in batches, each of which is set up, solved on
+// g_numThreads threads, and then reported in the order of the supports,
+// so the output does not depend on the number of threads.
+//
+void SolveStrategic(const Gambit::Game &p_nfg)
+{
+  Gambit::List<Gambit::StrategySupport> supports = PossibleNashSubsupports(p_nfg);
+  Gambit::List<Gambit::MixedStrategyProfile<double> > equilibria;
+  int batchSize = SUPPORTS_PER_THREAD * g_numThreads;
+
+  for (int first = 1; first <= supports.Length(); first += batchSize) {
+    // std::min is not usable here, as the Pelican headers define min()
+    int last = first + batchSize - 1;
+    if (last > supports.Length()) last = supports.Length();
+    Gambit::Array<PolEnumModule *> modules(last - first + 1);
+    for (int i = first; i <= last; i++) {
+      modules[i - first + 1] = new PolEnumModule(supports[i]);
+      modules[i - first + 1]->SetUpEquations();
+    }
 
+    FindRootsTask task(modules);
+    try {
+      Gambit::RunParallel(task, (g_numThreads < modules.Length()) ?
+			  g_numThreads : modules.Length());
+    }
+    catch (...) {
+      for (int i = 1; i <= modules.Length(); i++) {
+	delete modules[i];
+      }
+      throw;
+    }
 
+    for (int i = first; i <= last; i++) {
+      PolEnumModule *module = modules[i - first + 1];
+      if (g_verbose) {
+	PrintSupport(std::cout, "candidate", supports[i]);
+      }
+
+      module->SaveRoots();
+      const Gambit::List<Gambit::MixedStrategyProfile<double> > &newsolns =
+	module->GetSolutions();
+      for (int j = 1; j <= newsolns.Length(); j++) {
+	Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+	if (fullProfile.GetLiapValue() >= 1.0e-6) continue;
+	bool isNew = true;
+	for (int k = 1; isNew && k <= equilibria.Length(); k++) {
+	  isNew = !IsSameProfile(fullProfile, equilibria[k]);
+	}
+	if (isNew) {
+	  equilibria.Append(fullProfile);
+	  PrintProfile(std::cout, "NE", fullProfile);
+	}
+      }
 
+      if (module->IsSingular() && g_verbose) {
+	PrintSupport(std::cout, "singular", supports[i]);
+      }
+      delete module;
+    }
+  }
+}
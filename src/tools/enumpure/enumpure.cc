@@ -21,12 +21,16 @@
 //
 
 #include <cstdlib>
+#include <algorithm>
 #include <getopt.h>
 #include <unistd.h>
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <vector>
 #include "libgambit/libgambit.h"
+#include "libgambit/gametable.h"
+#include "libgambit/parallel.h"
 #include "libgambit/subgame.h"
 
 using namespace Gambit;
@@ -114,18 +118,176 @@ void MixedStrategyAsBehavCSVRenderer<T>::Render(const MixedStrategyProfile<T> &p
 }
 
 
+//
+// The best-response table of a strategic game.  For each player, and
+// each profile of strategies of the other players, this points to the
+// best payoff the player can get against that profile.  A contingency
+// is then an equilibrium if each player's payoff is as good as the best
+// payoff against the others' strategies, so each contingency is checked
+// once per player rather than once per strategy.
+//
+// Contingencies are numbered from zero in the order of the game table,
+// with player 1's strategy varying fastest.
+//
+class BestResponseTable {
+private:
+  int m_numPlayers;
+  Array<int> m_dims;
+  Array<long> m_strides;
+  long m_numContingencies;
+  Array<const Rational *> m_payoffs;
+  Array<std::vector<const Rational *> > m_best;
+
+  class BuildTask : public ParallelTask {
+  private:
+    BestResponseTable &m_table;
+  public:
+    BuildTask(BestResponseTable &p_table) : m_table(p_table) { }
+    virtual ~BuildTask() { }
+    virtual void Run(int p_part, int p_numParts);
+  };
+  friend class BuildTask;
+
+  /// The index of the profile of the other players' strategies
+  long GetOpponentIndex(long p_index, int pl) const
+  { return (p_index % m_strides[pl] + 
+	    p_index / (m_strides[pl] * m_dims[pl]) * m_strides[pl]); }
+
+public:
+  BestResponseTable(const GameTableRep &p_game, int p_numThreads);
+
+  long NumContingencies(void) const { return m_numContingencies; }
+  /// Is the contingency a pure strategy Nash equilibrium?
+  bool IsNash(long p_index) const;
+  /// The profile of strategies played in the contingency
+  PureStrategyProfile GetProfile(const Game &p_game, long p_index) const;
+};
+
+BestResponseTable::BestResponseTable(const GameTableRep &p_game, 
+				     int p_numThreads)
+  : m_numPlayers(p_game.NumPlayers()), m_dims(p_game.NumStrategies()),
+    m_strides(m_numPlayers), m_payoffs(m_numPlayers), m_best(m_numPlayers)
+{
+  m_numContingencies = 1L;
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    m_strides[pl] = m_numContingencies;
+    m_numContingencies *= m_dims[pl];
+  }
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    m_payoffs[pl] = p_game.GetPayoffTable<Rational>(pl);
+    m_best[pl].resize(m_numContingencies / m_dims[pl]);
+  }
+
+  BuildTask task(*this);
+  RunParallel(task, p_numThreads);
+}
+
+//
+// Each part fills in a contiguous range of opponent profiles for each
+// player, so the parts write to disjoint parts of the table.
+//
+void BestResponseTable::BuildTask::Run(int p_part, int p_numParts)
+{
+  for (int pl = 1; pl <= m_table.m_numPlayers; pl++) {
+    long stride = m_table.m_strides[pl];
+    int dim = m_table.m_dims[pl];
+    const Rational *payoffs = m_table.m_payoffs[pl];
+    std::vector<const Rational *> &best = m_table.m_best[pl];
+    long size = best.size();
+    long begin = size * (p_part - 1) / p_numParts;
+    long end = size * p_part / p_numParts;
+    for (long opp = begin; opp < end; opp++) {
+      const Rational *payoff = payoffs + (opp % stride + 
+					  opp / stride * stride * dim);
+      best[opp] = payoff;
+      for (int st = 2; st <= dim; st++) {
+	payoff += stride;
+	if (*payoff > *best[opp]) {
+	  best[opp] = payoff;
+	}
+      }
+    }
+  }
+}
+
+bool BestResponseTable::IsNash(long p_index) const
+{
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    const Rational *payoff = m_payoffs[pl] + p_index;
+    const Rational *best = m_best[pl][GetOpponentIndex(p_index, pl)];
+    if (best != payoff && *best > *payoff) {
+      return false;
+    }
+  }
+  return true;
+}
+
+PureStrategyProfile BestResponseTable::GetProfile(const Game &p_game, 
+						  long p_index) const
+{
+  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    int st = p_index / m_strides[pl] % m_dims[pl] + 1;
+    profile->SetStrategy(p_game->GetPlayer(pl)->GetStrategy(st));
+  }
+  return profile;
+}
+
+//
+// Checks a range of contingencies for equilibria.  The range is split 
+// into equal consecutive blocks, one for each part, and each part 
+// records the equilibria in its block in order.
+//
+class BestResponseScanTask : public ParallelTask {
+private:
+  const BestResponseTable &m_table;
+  long m_begin, m_end;
+  Array<std::vector<long> > m_found;
+
+public:
+  BestResponseScanTask(const BestResponseTable &p_table, int p_numParts)
+    : m_table(p_table), m_begin(0), m_end(0), m_found(p_numParts) { }
+  virtual ~BestResponseScanTask() { }
+
+  void SetRange(long p_begin, long p_end)  
+  { m_begin = p_begin;  m_end = p_end; }
+  const std::vector<long> &GetFound(int p_part) const
+  { return m_found[p_part]; }
+
+  virtual void Run(int p_part, int p_numParts);
+};
+
+void BestResponseScanTask::Run(int p_part, int p_numParts)
+{
+  std::vector<long> &found = m_found[p_part];
+  found.clear();
+  long size = m_end - m_begin;
+  long end = m_begin + size * p_part / p_numParts;
+  for (long index = m_begin + size * (p_part - 1) / p_numParts;
+       index < end; index++) {
+    if (m_table.IsNash(index)) {
+      found.push_back(index);
+    }
+  }
+}
+
 class NashEnumPureStrategySolver {
 private:
   MixedStrategyRenderer<Rational> *m_onEquilibrium;
+  int m_numThreads;
+
+  List<MixedStrategyProfile<Rational> > SolveTable(const Game &p_game) const;
 
 public:
-  NashEnumPureStrategySolver(MixedStrategyRenderer<Rational> *p_onEquilibrium = 0);
+  NashEnumPureStrategySolver(MixedStrategyRenderer<Rational> *p_onEquilibrium = 0,
+			     int p_numThreads = 1);
   ~NashEnumPureStrategySolver()  { delete m_onEquilibrium; }
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
 };
 
-NashEnumPureStrategySolver::NashEnumPureStrategySolver(MixedStrategyRenderer<Rational> *p_onEquilibrium /* = 0 */)
-  : m_onEquilibrium(p_onEquilibrium)
+NashEnumPureStrategySolver::NashEnumPureStrategySolver(MixedStrategyRenderer<Rational> *p_onEquilibrium /* = 0 */,
+						       int p_numThreads /* = 1 */)
+  : m_onEquilibrium(p_onEquilibrium), m_numThreads(p_numThreads)
 {
   if (!m_onEquilibrium) {
     m_onEquilibrium = new MixedStrategyNullRenderer<Rational>();
@@ -135,6 +297,10 @@ NashEnumPureStrategySolver::NashEnumPureStrategySolver(MixedStrategyRenderer<Rat
 List<MixedStrategyProfile<Rational> >
 NashEnumPureStrategySolver::Solve(const Game &p_game) const
 {
+  if (dynamic_cast<GameTableRep *>(p_game.operator->())) {
+    return SolveTable(p_game);
+  }
+
   List<MixedStrategyProfile<Rational> > solutions;
   for (StrategyIterator citer(p_game); !citer.AtEnd(); citer++) {
     if ((*citer)->IsNash()) {
@@ -146,6 +312,41 @@ NashEnumPureStrategySolver::Solve(const Game &p_game) const
   return solutions;
 }
 
+//
+// On table games, the contingencies are checked against the 
+// best-response table.  They are checked in rounds of one block per
+// thread, and the equilibria found in each round are rendered before 
+// the next one starts, so they come out in the same order as with one
+// thread.
+//
+List<MixedStrategyProfile<Rational> >
+NashEnumPureStrategySolver::SolveTable(const Game &p_game) const
+{
+  const long BLOCK_SIZE = 1L << 16;
+
+  BestResponseTable table(dynamic_cast<GameTableRep &>(*p_game), 
+			  m_numThreads);
+  BestResponseScanTask task(table, m_numThreads);
+
+  List<MixedStrategyProfile<Rational> > solutions;
+  for (long begin = 0; begin < table.NumContingencies(); 
+       begin += BLOCK_SIZE * m_numThreads) {
+    task.SetRange(begin, std::min(begin + BLOCK_SIZE * m_numThreads,
+				  table.NumContingencies()));
+    RunParallel(task, m_numThreads);
+    for (int part = 1; part <= m_numThreads; part++) {
+      const std::vector<long> &found = task.GetFound(part);
+      for (size_t i = 0; i < found.size(); i++) {
+	MixedStrategyProfile<Rational> profile = 
+	  table.GetProfile(p_game, found[i])->ToMixedStrategyProfile();
+	m_onEquilibrium->Render(profile);
+	solutions.Append(profile);
+      }
+    }
+  }
+  return solutions;
+}
+
 
 
 template <class T> class BehavStrategyRenderer {
@@ -244,6 +445,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               use strategic game (default)\n";
   std::cerr << "  -A               return agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -j THREADS       number of threads to use on strategic games (default 1)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -255,6 +457,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useAgent = false, bySubgames = false;
+  int numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -263,7 +466,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "vhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "vhqASPj:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -276,6 +479,13 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      if (numThreads < 1) {
+	std::cerr << argv[0] << ": Number of threads must be positive.\n";
+	return 1;
+      }
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -325,7 +535,7 @@ int main(int argc, char *argv[])
 	}
       }
       else if (useStrategic)  {
-	NashEnumPureStrategySolver algorithm = NashEnumPureStrategySolver(new MixedStrategyCSVRenderer<Rational>(std::cout));
+	NashEnumPureStrategySolver algorithm = NashEnumPureStrategySolver(new MixedStrategyCSVRenderer<Rational>(std::cout), numThreads);
 	algorithm.Solve(game);
       }
       else if (useAgent) {
@@ -333,12 +543,12 @@ int main(int argc, char *argv[])
 	algorithm.Solve(game);
       }
       else {
-	NashEnumPureStrategySolver algorithm = NashEnumPureStrategySolver(new MixedStrategyAsBehavCSVRenderer<Rational>(std::cout));
+	NashEnumPureStrategySolver algorithm = NashEnumPureStrategySolver(new MixedStrategyAsBehavCSVRenderer<Rational>(std::cout), numThreads);
 	algorithm.Solve(game);
       }
     }
     else {
-      NashEnumPureStrategySolver algorithm = NashEnumPureStrategySolver(new MixedStrategyCSVRenderer<Rational>(std::cout));
+      NashEnumPureStrategySolver algorithm = NashEnumPureStrategySolver(new MixedStrategyCSVRenderer<Rational>(std::cout), numThreads);
       algorithm.Solve(game);
     }
     return 0;
@@ -159,6 +159,12 @@ private:
   T maxpay,eps;
   List<BFS<T> > m_list;
   List<GameInfoset> isets1, isets2;
+  // For each player, the position of each infoset in the list of
+  // reachable ones (0 if unreachable), and the number of sequences
+  // of the infosets ahead of it in that list
+  Array<Array<int> > m_isetIndex, m_seqOffset;
+
+  void IndexInfosets(const BehavSupport &, int pl, const List<GameInfoset> &);
 
   void FillTableau(const BehavSupport &, Matrix<T> &, const GameNode &, T,
 		   int, int, int, int);
@@ -231,6 +237,10 @@ SolveEfgLcp<T>::Solve(const BehavSupport &p_support, bool p_print /*= true*/)
 
   isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
   isets2 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(2));
+  m_isetIndex = Array<Array<int> >(2);
+  m_seqOffset = Array<Array<int> >(2);
+  IndexInfosets(p_support, 1, isets1);
+  IndexInfosets(p_support, 2, isets2);
 
   m_list = List<BFS<T> >();
 
@@ -398,6 +408,24 @@ SolveEfgLcp<T>::AllLemke(const BehavSupport &p_support,
   return 1;
 }
 
+template <class T>
+void SolveEfgLcp<T>::IndexInfosets(const BehavSupport &p_support, int pl,
+				   const List<GameInfoset> &p_isets)
+{
+  m_isetIndex[pl] = Array<int>(p_support.GetGame()->GetPlayer(pl)->NumInfosets());
+  for (int i = 1; i <= m_isetIndex[pl].Length(); i++) {
+    m_isetIndex[pl][i] = 0;
+  }
+  m_seqOffset[pl] = Array<int>(p_isets.Length());
+
+  int offset = 0;
+  for (int i = 1; i <= p_isets.Length(); i++) {
+    m_isetIndex[pl][p_isets[i]->GetNumber()] = i;
+    m_seqOffset[pl][i] = offset;
+    offset += p_support.NumActions(pl, p_isets[i]->GetNumber());
+  }
+}
+
 template <class T>
 void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
 				 const GameNode &n, T prob,
@@ -422,12 +450,8 @@ void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
     }
     int pl = n->GetPlayer()->GetNumber();
     if (pl==1) {
-      i1=isets1.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i1; i++) {
-	snew+=p_support.NumActions(isets1[i]->GetPlayer()->GetNumber(),
-				   isets1[i]->GetNumber());
-      }
+      i1=m_isetIndex[1][n->GetInfoset()->GetNumber()];
+      snew=1+m_seqOffset[1][i1];
       A(s1,ns1+ns2+i1+1) = -(T)1;
       A(ns1+ns2+i1+1,s1) = (T)1;
       for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
@@ -437,12 +461,8 @@ void SolveEfgLcp<T>::FillTableau(const BehavSupport &p_support, Matrix<T> &A,
       }
     }
     if(pl==2) {
-      i2=isets2.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i2; i++) {
-	snew+=p_support.NumActions(isets2[i]->GetPlayer()->GetNumber(),
-				   isets2[i]->GetNumber());
-      }
+      i2=m_isetIndex[2][n->GetInfoset()->GetNumber()];
+      snew=1+m_seqOffset[2][i2];
       A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
       A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
       for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
@@ -473,11 +493,8 @@ void SolveEfgLcp<T>::GetProfile(const BehavSupport &p_support,
       }
     }
     else if (pl == 1) {
-      int inf = isets1.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(1, isets1[i]->GetNumber()); 
-      }
+      int inf = m_isetIndex[1][iset];
+      int snew = 1 + m_seqOffset[1][inf];
       
       for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -498,11 +515,8 @@ void SolveEfgLcp<T>::GetProfile(const BehavSupport &p_support,
       }
     }
     else if (pl == 2) { 
-      int inf = isets2.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(2, isets2[i]->GetNumber()); 
-      }
+      int inf = m_isetIndex[2][iset];
+      int snew = 1 + m_seqOffset[2][inf];
 
       for (int i = 1; i<= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -61,6 +61,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
+  std::cerr << "  -j THREADS       number of threads to use on strategic games (default 1)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -71,6 +72,7 @@ int g_numDecimals = 6;
 bool g_printDetail = false;
 int g_stopAfter = 0;
 int g_maxDepth = 0;
+int g_numThreads = 1;
 
 extern void PrintProfile(std::ostream &, const std::string &,
 			 const MixedBehavProfile<double> &);
@@ -89,7 +91,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:j:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -103,6 +105,13 @@ int main(int argc, char *argv[])
     case 'e':
       g_stopAfter = atoi(optarg);
       break;
+    case 'j':
+      g_numThreads = atoi(optarg);
+      if (g_numThreads < 1) {
+	std::cerr << argv[0] << ": Number of threads must be positive.\n";
+	return 1;
+      }
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
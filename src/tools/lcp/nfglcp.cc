@@ -23,13 +23,18 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "libgambit/libgambit.h"
+#include "libgambit/parallel.h"
 #include "lhtab.h"
 
 using namespace Gambit;
 
-extern int g_numDecimals, g_stopAfter, g_maxDepth;
+extern int g_numDecimals, g_stopAfter, g_maxDepth, g_numThreads;
 extern bool g_printDetail;
 
 namespace {
@@ -118,22 +123,44 @@ template <class T> Vector<T> Make_b2(const StrategySupport &);
 
 
 //
-// Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
-// The corresponding equilibrium is computed and output.
-// Returns 'true' if the CBFS is new; 'false' if it already appears in the
-// list.
+// The equilibria are told apart by their basic variables, which are
+// listed in increasing order as the signature of the basis.
 //
 template <class T>
-bool OnBFS(const StrategySupport &p_support,
-	   List<BFS<T> > &p_list, LHTableau<T> &p_tableau)
+std::vector<int> BasisSignature(const LHTableau<T> &p_tableau)
 {
-  BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_list.Contains(cbfs)) {
-    return false;
+  std::vector<int> signature;
+  for (int i = p_tableau.MinCol(); i <= p_tableau.MaxCol(); i++) {
+    if (p_tableau.Member(i)) {
+      signature.push_back(i);
+    }
+  }
+  return signature;
+}
+
+//
+// Returns 'true' if the CBFS is the trivial (extraneous) one.
+//
+template <class T>
+bool IsTrivial(const StrategySupport &p_support, BFS<T> &cbfs)
+{
+  T sum = (T) 0;
+  for (int j = 1; j <= p_support.NumStrategies(1); j++) {
+    if (cbfs.count(j))   sum += cbfs[j];
   }
+  return (sum == (T) 0);
+}
 
-  p_list.Append(cbfs);
+//
+// Computes and outputs the equilibrium corresponding to a CBFS.
+// Returns 'false' if the CBFS is the trivial one.
+//
+template <class T>
+bool PrintEquilibrium(const StrategySupport &p_support, BFS<T> &cbfs)
+{
+  if (IsTrivial(p_support, cbfs)) {
+    return false;
+  }
 
   MixedStrategyProfile<T> profile(p_support.NewMixedStrategyProfile<T>());
   int n1 = p_support.NumStrategies(1);
@@ -144,11 +171,6 @@ bool OnBFS(const StrategySupport &p_support,
     if (cbfs.count(j))   sum += cbfs[j];
   }
 
-  if (sum == (T) 0)  {
-    // This is the trivial CBFS.
-    return false;
-  }
-
   for (int j = 1; j <= n1; j++) {
     if (cbfs.count(j)) {
       profile[p_support.GetStrategy(1, j)] = cbfs[j] / sum;
@@ -177,8 +199,30 @@ bool OnBFS(const StrategySupport &p_support,
   if (g_printDetail) {
     PrintProfileDetail(std::cout, profile);
   }
+  return true;
+}
+
+//
+// Function called when a CBFS is encountered.
+// If its basis is not already in the set p_found, it is added.
+// The corresponding equilibrium is computed and output.
+// Returns 'true' if the CBFS is new; 'false' if it already appears in the
+// set.
+//
+template <class T>
+bool OnBFS(const StrategySupport &p_support,
+	   std::set<std::vector<int> > &p_found, LHTableau<T> &p_tableau)
+{
+  if (!p_found.insert(BasisSignature(p_tableau)).second) {
+    return false;
+  }
 
-  if (g_stopAfter > 0 && p_list.Length() >= g_stopAfter) {
+  BFS<T> cbfs(p_tableau.GetBFS());
+  if (!PrintEquilibrium(p_support, cbfs)) {
+    return false;
+  }
+
+  if (g_stopAfter > 0 && (int) p_found.size() >= g_stopAfter) {
     throw EquilibriumLimitReachedNfg();
   }
 
@@ -187,14 +231,14 @@ bool OnBFS(const StrategySupport &p_support,
 
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
-// calling itself.  p_list maintains the list of basic variables 
+// calling itself.  p_found maintains the set of bases
 // for the equilibria that have already been found.  
 // From each new accessible equilibrium, it follows
-// all possible paths, adding any new equilibria to the List.  
+// all possible paths, adding any new equilibria to the set.  
 //
 template <class T> void AllLemke(const StrategySupport &p_support,
 				 int j, LHTableau<T> &B,
-				 List<BFS<T> > &p_list,
+				 std::set<std::vector<int> > &p_found,
 				 int depth)
 {
   if (g_maxDepth != 0 && depth > g_maxDepth) {
@@ -203,7 +247,7 @@ template <class T> void AllLemke(const StrategySupport &p_support,
 
   // On the initial depth=0 call, the CBFS we are at is the extraneous
   // solution.
-  if (depth > 0 && !OnBFS(p_support, p_list, B)) {
+  if (depth > 0 && !OnBFS(p_support, p_found, B)) {
     return;
   }
   
@@ -211,16 +255,190 @@ template <class T> void AllLemke(const StrategySupport &p_support,
     if (i != j)  {
       LHTableau<T> Bcopy(B);
       Bcopy.LemkePath(i);
-      AllLemke(p_support, i, Bcopy, p_list, depth+1);
+      AllLemke(p_support, i, Bcopy, p_found, depth+1);
     }
   }
 }
 
+//
+// The search of AllLemke, with the paths followed by several threads.
+// The equilibria are visited in the same order as by AllLemke, and the
+// paths from each new one are queued as it is visited, so the threads
+// follow the same paths as AllLemke does.  The visit goes on, under the
+// lock, each time a path it waits for has been followed; equilibria are
+// output as soon as they are visited, as AllLemke outputs them.
+//
+template <class T> class ParallelLemke : public ParallelTask {
+private:
+  // A visited equilibrium whose paths are being followed, with the
+  // label of the path it was reached by, and the next label to look at
+  struct Frame {
+    int m_vertex, m_label, m_next;
+  };
+
+  const StrategySupport &m_support;
+  // The tableaus at the equilibria visited and not trivial, in order;
+  // the first is the extraneous solution the search starts from
+  std::vector<LHTableau<T> *> m_tableaus;
+  // The tableaus at the ends of the paths followed from each of them,
+  // by label, until the visit gets to them
+  std::vector<std::map<int, LHTableau<T> *> > m_ends;
+  std::set<std::vector<int> > m_found;
+  std::vector<Frame> m_stack;
+  // The paths waiting to be followed, as a vertex and a label, with 
+  // those the visit needs soonest in front
+  std::list<std::pair<int, int> > m_paths;
+  int m_numRunning;
+  bool m_stop;
+  Mutex m_mutex;
+  Condition m_condition;
+
+  void AddVertex(LHTableau<T> *, int p_label, int p_depth);
+  void Visit(LHTableau<T> *, int p_label, int p_depth);
+  void Advance(void);
+
+public:
+  ParallelLemke(const StrategySupport &p_support, 
+		const LHTableau<T> &p_start);
+  virtual ~ParallelLemke();
+
+  virtual void Run(int p_part, int p_numParts);
+};
+
+template <class T>
+ParallelLemke<T>::ParallelLemke(const StrategySupport &p_support,
+				const LHTableau<T> &p_start)
+  : m_support(p_support), m_numRunning(0), m_stop(false)
+{
+  AddVertex(new LHTableau<T>(p_start), 0, 0);
+}
+
+template <class T> ParallelLemke<T>::~ParallelLemke()
+{
+  // Floating-point tableaus share data with the tableaus they were
+  // copied from, so these must be deleted last
+  for (int i = m_tableaus.size() - 1; i >= 0; i--) {
+    for (typename std::map<int, LHTableau<T> *>::iterator end = m_ends[i].begin();
+	 end != m_ends[i].end(); ++end) {
+      delete end->second;
+    }
+    delete m_tableaus[i];
+  }
+}
+
+template <class T>
+void ParallelLemke<T>::AddVertex(LHTableau<T> *p_tableau, 
+				 int p_label, int p_depth)
+{
+  int vertex = m_tableaus.size();
+  m_tableaus.push_back(p_tableau);
+  m_ends.push_back(std::map<int, LHTableau<T> *>());
+
+  // As in AllLemke, the paths ending deeper than the limit are not
+  // followed
+  if (g_maxDepth != 0 && p_depth + 1 > g_maxDepth) {
+    return;
+  }
+  Frame frame = { vertex, p_label, p_tableau->MinCol() };
+  m_stack.push_back(frame);
+  for (int i = p_tableau->MaxCol(); i >= p_tableau->MinCol(); i--) {
+    if (i != p_label) {
+      m_paths.push_front(std::make_pair(vertex, i));
+    }
+  }
+}
+
+template <class T>
+void ParallelLemke<T>::Visit(LHTableau<T> *p_tableau, 
+			     int p_label, int p_depth)
+{
+  if (!m_found.insert(BasisSignature(*p_tableau)).second) {
+    delete p_tableau;
+    return;
+  }
+
+  BFS<T> cbfs(p_tableau->GetBFS());
+  if (!PrintEquilibrium(m_support, cbfs)) {
+    delete p_tableau;
+    return;
+  }
+  AddVertex(p_tableau, p_label, p_depth);
+
+  if (g_stopAfter > 0 && (int) m_found.size() >= g_stopAfter) {
+    m_stop = true;
+  }
+}
+
+template <class T> void ParallelLemke<T>::Advance(void)
+{
+  while (!m_stack.empty() && !m_stop) {
+    Frame &frame = m_stack.back();
+    if (frame.m_next > m_tableaus[frame.m_vertex]->MaxCol()) {
+      m_stack.pop_back();
+      continue;
+    }
+    int label = frame.m_next;
+    if (label == frame.m_label) {
+      frame.m_next++;
+      continue;
+    }
+    std::map<int, LHTableau<T> *> &ends = m_ends[frame.m_vertex];
+    typename std::map<int, LHTableau<T> *>::iterator end = ends.find(label);
+    if (end == ends.end()) {
+      // The path has not been followed yet
+      return;
+    }
+    LHTableau<T> *tableau = end->second;
+    ends.erase(end);
+    frame.m_next++;
+    Visit(tableau, label, m_stack.size());
+  }
+}
+
+template <class T> void ParallelLemke<T>::Run(int, int)
+{
+  MutexLock lock(m_mutex);
+  while (true) {
+    while (m_paths.empty() && m_numRunning > 0 && !m_stop) {
+      m_condition.Wait(m_mutex);
+    }
+    if (m_paths.empty() || m_stop) {
+      return;
+    }
+
+    int from = m_paths.front().first, label = m_paths.front().second;
+    m_paths.pop_front();
+    const LHTableau<T> *start = m_tableaus[from];
+    m_numRunning++;
+
+    m_mutex.Unlock();
+    LHTableau<T> *tableau = 0;
+    try {
+      tableau = new LHTableau<T>(*start);
+      tableau->LemkePath(label);
+    }
+    catch (...) {
+      delete tableau;
+      m_mutex.Lock();
+      m_numRunning--;
+      m_stop = true;
+      m_condition.Broadcast();
+      throw;
+    }
+    m_mutex.Lock();
+    m_numRunning--;
+
+    m_ends[from][label] = tableau;
+    Advance();
+    m_condition.Broadcast();
+  }
+}
+
 template <class T>
 void SolveStrategic(const Game &p_game)
 {
   StrategySupport support(p_game);
-  List<BFS<T> > bfsList;
+  std::set<std::vector<int> > found;
 
   try {
     Matrix<T> A1 = Make_A1<T>(support);
@@ -229,19 +447,23 @@ void SolveStrategic(const Game &p_game)
     Vector<T> b2 = Make_b2<T>(support);
     LHTableau<T> B(A1, A2, b1, b2);
 
-    if (g_stopAfter != 1) {
+    if (g_stopAfter == 1) {
+      B.LemkePath(1);
+      OnBFS(support, found, B);
+    }
+    else if (g_numThreads > 1) {
+      ParallelLemke<T> search(support, B);
+      RunParallel(search, g_numThreads);
+    }
+    else {
       try {
-	AllLemke(support, 0, B, bfsList, 0);
+	AllLemke(support, 0, B, found, 0);
       }
       catch (EquilibriumLimitReachedNfg &) {
 	// This pseudo-exception requires no additional action;
-	// bfsList will contain the list of equilibria found
+	// found will contain the set of equilibria found
       }
     }
-    else  {
-      B.LemkePath(1);
-      OnBFS(support, bfsList, B);
-    }
 
     return;
   }
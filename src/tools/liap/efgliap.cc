@@ -71,8 +71,7 @@ EFLiapFunc::~EFLiapFunc()
 double EFLiapFunc::Value(const Gambit::Vector<double> &v) const
 {
   _nevals++;
-  ((Gambit::Vector<double> &) _p).operator=(v);
-    //_p = v;
+  _p = v;
   return _p.GetLiapValue();
 }
 
@@ -104,7 +103,7 @@ bool EFLiapFunc::Gradient(const Gambit::Vector<double> &x,
 {
   const double DELTA = .00001;
 
-  ((Gambit::Vector<double> &) _p).operator=(x);
+  _p = x;
   for (int i = 1; i <= x.Length(); i++) {
     _p[i] += DELTA;
     double value = _p.GetLiapValue();
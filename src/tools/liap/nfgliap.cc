@@ -52,7 +52,10 @@ private:
   double Value(const Gambit::Vector<double> &) const;
   bool Gradient(const Gambit::Vector<double> &, Gambit::Vector<double> &) const;
 
-  double LiapDerivValue(int, int, const Gambit::MixedStrategyProfile<double> &) const;
+  double LiapDerivValue(int, int, const Gambit::MixedStrategyProfile<double> &,
+			const Gambit::Vector<double> &,
+			const Gambit::Vector<double> &,
+			const Gambit::Matrix<double> &) const;
     
 
 public:
@@ -71,34 +74,46 @@ NFLiapFunc::~NFLiapFunc()
 { }
 
 double NFLiapFunc::LiapDerivValue(int i1, int j1,
-				  const Gambit::MixedStrategyProfile<double> &p) const
+				  const Gambit::MixedStrategyProfile<double> &p,
+				  const Gambit::Vector<double> &payoffs,
+				  const Gambit::Vector<double> &values,
+				  const Gambit::Matrix<double> &derivs) const
 {
-  int i, j;
+  int i, j, k, index, index1;
   double x, x1, psum;
+
+  // The profile index of the strategy
+  for (index1 = j1, i = 1; i < i1; index1 += p.GetSupport().NumStrategies(i++));
   
   x = 0.0;
-  for (i = 1; i <= _nfg->NumPlayers(); i++)  {
+  for (i = 1, index = 1; i <= _nfg->NumPlayers(); i++)  {
+    // The derivative of player i's payoff with respect to the strategy
+    double deriv = 0.0;
+    if (i != i1) {
+      for (k = 1; k <= p.GetSupport().NumStrategies(i); k++) {
+	if (p[index + k - 1] > 0.0) {
+	  deriv += p[index + k - 1] * derivs(index + k - 1, index1);
+	}
+      }
+    }
+
     psum = 0.0;
-    for (j = 1; j <= p.GetSupport().NumStrategies(i); j++)  {
-      psum += p[p.GetSupport().GetStrategy(i,j)];
-      x1 = p.GetPayoff(p.GetSupport().GetStrategy(i, j)) - p.GetPayoff(i);
+    for (j = 1; j <= p.GetSupport().NumStrategies(i); j++, index++)  {
+      psum += p[index];
+      x1 = values[index] - payoffs[i];
       if (i1 == i) {
 	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, p.GetSupport().GetStrategy(i1, j1));
+	  x -= x1 * values[index1];
       }
       else {
 	if (x1> 0.0)
-	  x += x1 * (p.GetPayoffDeriv(i, 
-				      p.GetSupport().GetStrategy(i, j),
-				      p.GetSupport().GetStrategy(i1, j1)) - 
-		     p.GetPayoffDeriv(i,
-				      p.GetSupport().GetStrategy(i1, j1)));
+	  x += x1 * (derivs(index, index1) - deriv);
       }
     }
     if (i == i1)  x += 100.0 * (psum - 1.0);
   }
-  if (p[p.GetSupport().GetStrategy(i1, j1)] < 0.0) {
-    x += p[p.GetSupport().GetStrategy(i1, j1)];
+  if (p[index1] < 0.0) {
+    x += p[index1];
   }
   return 2.0 * x;
 }
@@ -130,10 +145,22 @@ bool NFLiapFunc::Gradient(const Gambit::Vector<double> &v, Gambit::Vector<double
 {
   ((Gambit::Vector<double> &) _p).operator=(v);
   int i1, j1, ii;
+
+  Gambit::Vector<double> payoffs(_nfg->NumPlayers());
+  Gambit::Vector<double> values(_p.MixedProfileLength());
+  Gambit::Matrix<double> derivs(_p.MixedProfileLength(), 
+				_p.MixedProfileLength());
+  _p.GetPayoffs(payoffs, values);
+  _p.GetPayoffDerivs(derivs);
+  // Unlike the strategy values, the payoffs also reflect negative
+  // probabilities, which the minimization can produce
+  for (int pl = 1; pl <= _nfg->NumPlayers(); pl++) {
+    payoffs[pl] = _p.GetPayoff(pl);
+  }
   
   for (i1 = 1, ii = 1; i1 <= _nfg->NumPlayers(); i1++) {
     for (j1 = 1; j1 <= _p.GetSupport().NumStrategies(i1); j1++) {
-      d[ii++] = LiapDerivValue(i1, j1, _p);
+      d[ii++] = LiapDerivValue(i1, j1, _p, payoffs, values, derivs);
     }
   }
 
@@ -81,8 +81,6 @@ protected:
   //@{
   void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
   
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
   void ComputeSolutionData(void) const;
   //@}
 
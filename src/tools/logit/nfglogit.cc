@@ -91,6 +91,9 @@ StrategicQREPathTracer::GetLHS(const Vector<double> &p_point, Vector<double> &p_
     logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
+  Vector<double> payoffs(support.NumPlayers());
+  Vector<double> values(profile.MixedProfileLength());
+  profile.GetPayoffs(payoffs, values);
   p_lhs = 0.0;
   for (int rowno = 0, pl = 1; pl <= support.NumPlayers(); pl++) {
     StrategySupportPlayer player = support.GetPlayer(pl);
@@ -107,8 +110,7 @@ StrategicQREPathTracer::GetLHS(const Vector<double> &p_point, Vector<double> &p_
 	// This is a ratio equation
 	p_lhs[rowno] = (logprofile[player->GetStrategy(st)] - 
 			logprofile[player->GetStrategy(1)] -
-			lambda * (profile.GetPayoff(player->GetStrategy(st)) -
-				  profile.GetPayoff(player->GetStrategy(1))));
+			lambda * (values[rowno] - values[rowno - st + 1]));
 
       }
     }
@@ -126,6 +128,12 @@ StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
     logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
+  Vector<double> payoffs(support.NumPlayers());
+  Vector<double> values(profile.MixedProfileLength());
+  profile.GetPayoffs(payoffs, values);
+  Matrix<double> derivs(profile.MixedProfileLength(), 
+			profile.MixedProfileLength());
+  profile.GetPayoffDerivs(derivs);
 
   p_matrix = 0.0;
 
@@ -165,19 +173,13 @@ StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
 	    else {
 	      p_matrix(colno, rowno) =
 		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
+		(derivs(rowno, colno) - derivs(rowno - j + 1, colno));
 	    }
 	  }
 	}
 	// Fill the last column, the derivative wrt lambda
-	p_matrix(p_matrix.NumRows(), rowno) =
-	  (profile.GetPayoff(player->GetStrategy(1)) - 
-	   profile.GetPayoff(player->GetStrategy(j)));
+	p_matrix(p_matrix.NumRows(), rowno) = 
+	  values[rowno - j + 1] - values[rowno];
       }
     }
   }
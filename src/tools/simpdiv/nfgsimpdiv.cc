@@ -439,20 +439,24 @@ Gambit::Rational nfgSimpdiv::getlabel(Gambit::MixedStrategyProfile<Gambit::Ratio
 			       Gambit::Array<int> &ylabel,
 			       Gambit::PVector<Gambit::Rational> &besty)
 {
-  int i,j,jj;
+  int i,j,jj,index;
   Gambit::Rational maxz,payoff,maxval;
   
   maxz=(Gambit::Rational(-1000000));
   
   ylabel[1]=1;
   ylabel[2]=1;
+
+  Gambit::Vector<Gambit::Rational> payoffs(yy.GetGame()->NumPlayers());
+  Gambit::Vector<Gambit::Rational> values(yy.MixedProfileLength());
+  yy.GetPayoffs(payoffs, values);
   
-  for(i=1;i<=yy.GetGame()->NumPlayers();i++) {
+  for(i=1,index=1;i<=yy.GetGame()->NumPlayers();i++) {
     payoff=Gambit::Rational(0);
     maxval=(Gambit::Rational(-1000000));
     jj=0;
-    for(j=1;j<=yy.GetSupport().NumStrategies(i);j++) {
-      pay=yy.GetPayoff(yy.GetSupport().GetStrategy(i,j));
+    for(j=1;j<=yy.GetSupport().NumStrategies(i);j++,index++) {
+      pay=values[index];
       payoff+=(yy[yy.GetSupport().GetStrategy(i,j)]*pay);
       if(pay>maxval) {
 	maxval=pay;